@@ -0,0 +1,18 @@
+import * as native from '../../binding';
+
+export const RTCCertificate: typeof globalThis.RTCCertificate = native.RTCCertificate;
+export type RTCCertificate = globalThis.RTCCertificate;
+
+export interface CertificatePoolStats {
+  /** The most certificates to keep ready. */
+  size: number;
+  /** Certificates ready now. */
+  available: number;
+  /** RTCPeerConnections that took a pooled certificate. */
+  hits: number;
+  /** RTCPeerConnections that found the pool empty. */
+  misses: number;
+}
+
+export const setCertificatePoolSize: (size: number) => void = native.setCertificatePoolSize;
+export const getCertificatePoolStats: () => CertificatePoolStats = native.getCertificatePoolStats;
@@ -0,0 +1,45 @@
+import * as native from '../../binding';
+
+export interface EventLoopBudget {
+  /**
+   * The most time, in milliseconds, to spend delivering events per wake-up,
+   * or 0 for no limit. Defaults to 10.
+   */
+  maxTime?: number;
+
+  /**
+   * The most events to deliver per wake-up, or 0 for no limit. Defaults to 0.
+   */
+  maxEvents?: number;
+}
+
+export interface EventLoopStats {
+  wakeups: number;
+  yields: number;
+}
+
+export interface EventQueueMetrics {
+  /** Events queued but not dispatched yet. */
+  depth: number;
+  /** The largest depth seen so far. */
+  highWaterDepth: number;
+  enqueued: number;
+  dispatched: number;
+  /** Events dropped by coalescing, or because their object was destroyed. */
+  dropped: number;
+  /** Time from enqueue to dispatch, in milliseconds. */
+  latency: {
+    mean: number;
+    max: number;
+    buckets: { le: number, count: number }[];
+  };
+  wakeups: number;
+  eventsPerWakeup: {
+    mean: number;
+    max: number;
+  };
+}
+
+export const setEventLoopBudget: (budget: EventLoopBudget) => void = native.setEventLoopBudget;
+export const getEventLoopStats: () => EventLoopStats = native.getEventLoopStats;
+export const getQueueMetrics: () => EventQueueMetrics = native.getQueueMetrics;
@@ -0,0 +1,184 @@
+import * as native from '../../binding';
+
+export interface NetworkConditions {
+  /**
+   * The one-way delay of each link, in milliseconds. Defaults to 0.
+   */
+  delay?: number;
+
+  /**
+   * The standard deviation of the delay, in milliseconds. Defaults to 0.
+   */
+  jitter?: number;
+
+  /**
+   * The fraction of packets dropped at random, from 0 to 1. Defaults to 0.
+   */
+  loss?: number;
+
+  /**
+   * The bandwidth of each link, in bits per second. Defaults to 0,
+   * unlimited.
+   */
+  bandwidth?: number;
+
+  /**
+   * The number of packets that may queue for a link's bandwidth before more
+   * are dropped. Defaults to 0, unlimited.
+   */
+  queueLength?: number;
+}
+
+/**
+ * Named NetworkConditions for running tests and benchmarks under realistic
+ * networks, with `inProcessNetwork`. Each link of a connection has the
+ * profile's conditions, so the round-trip time is twice the delay.
+ */
+export const networkProfiles: { readonly [name: string]: Readonly<NetworkConditions> } = {
+  // A congested home network: short, jittery delays and 2% loss.
+  'lossy-wifi': { delay: 5, jitter: 3, loss: 0.02, bandwidth: 20e6, queueLength: 100 },
+  // A mobile network: 150 ms round trips.
+  'lte': { delay: 75, jitter: 10, loss: 0.005, bandwidth: 5e6, queueLength: 100 },
+  // A geostationary satellite link: 600 ms round trips, capped at 1 Mbps.
+  'satellite': { delay: 300, jitter: 15, loss: 0.01, bandwidth: 1e6, queueLength: 50 }
+};
+
+export interface PeerConnectionFactoryOptions {
+  /**
+   * Only gather candidates on these networks. Each entry is an interface name
+   * (such as "eth0") or an IP address. Defaults to every network.
+   */
+  networks?: string[];
+
+  /**
+   * Enumerate networks once and share the result with every
+   * RTCPeerConnection, rather than re-enumerating while gathering. Defaults
+   * to false.
+   */
+  cacheNetworks?: boolean;
+
+  /**
+   * The number of UDP sockets to keep bound ahead of time for each local
+   * address and port range. Defaults to 0.
+   */
+  prebindSockets?: number;
+
+  /**
+   * The number of port allocators to keep gathering ahead of time for new
+   * RTCPeerConnections. Defaults to 0.
+   */
+  iceCandidatePoolSize?: number;
+
+  /**
+   * The ICE servers that pooled port allocators gather against. Only
+   * RTCPeerConnections with the same `iceServers` take from the pool.
+   * Defaults to none.
+   */
+  iceCandidatePoolServers?: RTCIceServer[];
+
+  /**
+   * The port range that pooled port allocators bind in. Only
+   * RTCPeerConnections with the same `portRange` take from the pool.
+   * Defaults to any port.
+   */
+  iceCandidatePoolPortRange?: { min?: number; max?: number };
+
+  /**
+   * Send and receive UDP with recvmmsg and sendmmsg (and UDP GSO and GRO,
+   * where the kernel supports them). Linux only. Defaults to false.
+   */
+  batchUdp?: boolean;
+
+  /**
+   * The receive buffer size of UDP sockets, in bytes. Defaults to 0, the
+   * system default.
+   */
+  udpReceiveBufferSize?: number;
+
+  /**
+   * The send buffer size of UDP sockets, in bytes. Defaults to 0, the system
+   * default.
+   */
+  udpSendBufferSize?: number;
+
+  /**
+   * Connect RTCPeerConnections through memory instead of the kernel's
+   * network stack. They can then only reach RTCPeerConnections of the same
+   * process. Defaults to false.
+   */
+  inProcessNetwork?: boolean;
+
+  /**
+   * The conditions of the in-process network's links. Defaults to a perfect
+   * network.
+   */
+  networkConditions?: NetworkConditions;
+
+  /**
+   * Create the PeerConnectionFactory without an audio device, audio
+   * processing, codecs or media engine. RTCPeerConnections can then only
+   * negotiate RTCDataChannels. Defaults to false.
+   */
+  dataOnly?: boolean;
+
+  /**
+   * Only play out remote audio while at least one RTCAudioSink is attached.
+   * Playout is what decodes and mixes remote audio, so without sinks no
+   * audio is decoded at all. Defaults to false.
+   */
+  playoutOnlyForSinks?: boolean;
+
+  /**
+   * Create the PeerConnectionFactory with an audio processing module.
+   * Without one, audio is never echo-cancelled, denoised, gain-controlled or
+   * filtered, whatever the options below. Defaults to true.
+   */
+  audioProcessing?: boolean;
+
+  /**
+   * Whether audio sources created through the factory ask for echo
+   * cancellation, unless their constraints say otherwise. Defaults to true.
+   */
+  echoCancellation?: boolean;
+
+  /**
+   * Whether audio sources ask for noise suppression. Defaults to true.
+   */
+  noiseSuppression?: boolean;
+
+  /**
+   * Whether audio sources ask for automatic gain control. Defaults to true.
+   */
+  autoGainControl?: boolean;
+
+  /**
+   * Whether audio sources ask for the high-pass filter. Defaults to true.
+   */
+  highpassFilter?: boolean;
+}
+
+export interface IceCandidatePoolStats {
+  /** The most port allocators to keep gathering. */
+  size: number;
+  /** Port allocators ready now. */
+  available: number;
+  /** RTCPeerConnections that took a pooled port allocator. */
+  hits: number;
+  /** RTCPeerConnections that could have, but found the pool empty. */
+  misses: number;
+}
+
+/**
+ * Set the options for the PeerConnectionFactory that RTCPeerConnections share.
+ * They take effect the next time it is created: when the first
+ * RTCPeerConnection is constructed, or after every RTCPeerConnection has been
+ * garbage collected.
+ */
+export const setPeerConnectionFactoryOptions: (options: PeerConnectionFactoryOptions) => void = native.setPeerConnectionFactoryOptions;
+
+/**
+ * Get the statistics of the current PeerConnectionFactory's ICE candidate
+ * pool. Every count is zero if there is no PeerConnectionFactory or it has no
+ * pool.
+ */
+export const getIceCandidatePoolStats: () => IceCandidatePoolStats = native.getIceCandidatePoolStats;
@@ -24,6 +24,11 @@ export * from "./rtpsender";
 export * from "./rtptransceiver";
 export * from "./sctptransport";
 export * from "./getusermedia";
+export * from "./eventloop";
+export * from "./tracing";
+export * from "./objectcounts";
+export * from "./certificates";
+export * from "./factory";
 
 import { MediaDevices } from './mediadevices';
 export const mediaDevices = new MediaDevices();
@@ -0,0 +1,28 @@
+import * as native from '../../binding';
+
+export interface NativeObjectTypeCounts {
+  /** Objects that have not been garbage collected yet. */
+  live: number;
+  /** Objects that raise events and have not stopped. */
+  running: number;
+  /** Events queued but not dispatched yet. */
+  pendingEvents: number;
+}
+
+export interface ExternalMemoryCounts {
+  videoFrames: number;
+  audioData: number;
+  dataChannelMessages: number;
+  buffers: number;
+  total: number;
+}
+
+export interface NativeObjectCounts {
+  /** Counts for each type constructed so far, by type name. */
+  objects: { [type: string]: NativeObjectTypeCounts };
+  pendingEvents: number;
+  /** Bytes of native memory held by ArrayBuffers, by kind. */
+  external: ExternalMemoryCounts;
+}
+
+export const getNativeObjectCounts: () => NativeObjectCounts = native.getNativeObjectCounts;
@@ -6,10 +6,20 @@ import { RTCPeerConnectionIceErrorEvent } from './rtcpeerconnectioniceerrorevent
 import { RTCSessionDescription } from './sessiondescription';
 import { RTCIceCandidate } from './icecandidate';
 import { RTCDataChannelEvent } from './datachannelevent';
+import type { EventQueueMetrics } from './eventloop';
 
 export declare class NRTCPeerConnection extends globalThis.RTCPeerConnection {
+  constructor(configuration?: RTCConfiguration, deferCreation?: boolean);
+  getQueueMetrics(): EventQueueMetrics;
+  _create(): Promise<void>;
 }
 
+/**
+ * Set while RTCPeerConnection.create() constructs an RTCPeerConnection, so
+ * that the native constructor defers creating the underlying connection.
+ */
+let deferCreation = false;
+
 /**
  * At no point should the managed event handler implementations throw an unexpected exception.
  * This ensures that behavior.
@@ -36,7 +46,25 @@ function ManagedHandler() {
 
 export class RTCPeerConnection extends (native.RTCPeerConnection as typeof NRTCPeerConnection) {
   constructor(options?: RTCConfiguration) {
-    super(options ?? {});
+    super(options ?? {}, deferCreation);
+  }
+
+  /**
+   * Create an RTCPeerConnection without blocking the event loop. The
+   * constructor waits while libwebrtc's signaling thread creates the
+   * underlying connection (including its DTLS certificate); this creates it
+   * on the signaling thread and resolves once it is ready.
+   */
+  static async create<T extends RTCPeerConnection>(this: new (options?: RTCConfiguration) => T, options?: RTCConfiguration): Promise<T> {
+    let pc: T;
+    deferCreation = true;
+    try {
+      pc = new this(options);
+    } finally {
+      deferCreation = false;
+    }
+    await pc._create();
+    return pc;
   }
 
   private emitter = new EventEmitter(this);
@@ -66,6 +94,18 @@ export class RTCPeerConnection extends (native.RTCPeerConnection as typeof NRTCP
     return super.addTrack(track, <any>streams);
   }
 
+  /**
+   * @internal
+   * Candidates gathered in quick succession arrive together, in the order they
+   * were gathered.
+   * @param candidates
+   */
+  _onicecandidates(candidates: RTCIceCandidateInit[]) {
+    for (const candidate of candidates) {
+      this._onicecandidate(candidate);
+    }
+  }
+
   /**
    * @internal
    * @param receiver 
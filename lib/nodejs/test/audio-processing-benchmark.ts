@@ -0,0 +1,97 @@
+/* eslint no-process-exit:0 */
+import { execFileSync } from 'child_process';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+
+import { AUDIO_PROCESSING_CONFIGS, environment, flagOption, listOption, numberOption, writeReport } from './lib/benchmark';
+
+/**
+ * Measures the CPU per audio track under each audio processing
+ * configuration (see docs/benchmarks.md). PeerConnectionFactoryOptions only
+ * apply to a new factory, so each configuration runs the density benchmark
+ * in a process of its own.
+ *
+ *   --configs <list>        comma-separated subset of AUDIO_PROCESSING_CONFIGS
+ *   --tracks <n>            audio connection pairs to measure (default 10)
+ *   --settle <ms>           passed to the density benchmark (default 1000)
+ *   --window <ms>           passed to the density benchmark (default 3000)
+ *   --in-process            passed to the density benchmark
+ *   --output <file>         write the JSON report to file instead of stdout
+ */
+
+function runDensity(config: string, tracks: number, settle: number, window: number, inProcess: boolean) {
+  const output = path.join(os.tmpdir(), `audio-processing-${process.pid}-${config}.json`);
+  const args = [
+    '--expose-gc',
+    '--enable-source-maps',
+    path.join(__dirname, 'density-benchmark.js'),
+    '--kinds', 'audio',
+    '--steps', String(tracks),
+    '--settle', String(settle),
+    '--window', String(window),
+    '--audio-processing', config,
+    '--output', output
+  ];
+  if (inProcess) {
+    args.push('--in-process');
+  }
+  execFileSync(process.execPath, args, { stdio: ['ignore', 'ignore', 'inherit'] });
+  try {
+    return JSON.parse(fs.readFileSync(output, 'utf8'));
+  } finally {
+    fs.unlinkSync(output);
+  }
+}
+
+async function main() {
+  const configs = listOption('configs', Object.keys(AUDIO_PROCESSING_CONFIGS), String);
+  const tracks = numberOption('tracks', 10);
+  const settle = numberOption('settle', 1000);
+  const window = numberOption('window', 3000);
+  const inProcess = flagOption('in-process');
+
+  for (const config of configs) {
+    if (!AUDIO_PROCESSING_CONFIGS[config]) {
+      throw new Error(`Unknown configuration "${config}"; expected one of ${Object.keys(AUDIO_PROCESSING_CONFIGS).join(', ')}`);
+    }
+  }
+
+  const results: any[] = [];
+  for (const config of configs) {
+    const report = runDensity(config, tracks, settle, window, inProcess);
+    const result = report.results[report.results.length - 1];
+    const perTrack = (percent: number) => percent / result.connections;
+    const threads: { [name: string]: number } = {};
+    for (const [name, percent] of Object.entries<number>(result.cpuPercent.threads)) {
+      threads[name] = perTrack(percent);
+    }
+    results.push({
+      config,
+      options: AUDIO_PROCESSING_CONFIGS[config],
+      tracks: result.connections,
+      cpuPercent: result.cpuPercent,
+      cpuPercentPerTrack: { process: perTrack(result.cpuPercent.process), threads }
+    });
+    console.error(
+      `${config}\t${result.connections} tracks\t`
+      + `cpu ${result.cpuPercent.process.toFixed(1)}%\tper track ${perTrack(result.cpuPercent.process).toFixed(2)}%\t`
+      + Object.entries(threads).map(([name, percent]) => `${name} ${percent.toFixed(2)}%`).join('\t')
+    );
+  }
+
+  writeReport({
+    version: 1,
+    benchmark: 'audio-processing',
+    environment: environment(),
+    settleMs: settle,
+    windowMs: window,
+    network: { inProcess },
+    results
+  });
+}
+
+main().then(() => process.exit(0), error => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,76 @@
+/* eslint no-process-exit:0 */
+import * as fs from 'fs';
+import binding from '../../../binding';
+import { option } from './lib/benchmark';
+
+/**
+ * Runs the native hot-path benchmarks (see docs/benchmarks.md). Requires a
+ * module configured with -DNODE_WEBRTC_BENCHMARKS=ON.
+ *
+ *   --filter <substring>    only run benchmarks whose name contains substring
+ *   --output <file>         write the JSON results to file instead of stdout
+ *   --baseline <file>       compare medians against an earlier run
+ *   --threshold <fraction>  allowed median regression vs. baseline (default 0.1)
+ */
+
+interface BenchmarkResult {
+    name: string;
+    iterations: number;
+    samples: number;
+    min: number;
+    median: number;
+    mean: number;
+    p90: number;
+    max: number;
+}
+
+interface BenchmarkReport {
+    version: number;
+    unit: string;
+    benchmarks: BenchmarkResult[];
+}
+
+if (typeof binding.benchmark !== 'function') {
+    console.error('This build of wrtc does not include benchmarks; configure it with -DNODE_WEBRTC_BENCHMARKS=ON.');
+    process.exit(1);
+}
+
+let json: string = binding.benchmark(option('filter'));
+let output = option('output');
+if (output) {
+    fs.writeFileSync(output, json);
+} else {
+    process.stdout.write(json);
+}
+
+let baselinePath = option('baseline');
+if (baselinePath) {
+    let threshold = Number(option('threshold') ?? 0.1);
+    let report: BenchmarkReport = JSON.parse(json);
+    let baseline: BenchmarkReport = JSON.parse(fs.readFileSync(baselinePath, 'utf8'));
+
+    if (baseline.version !== report.version) {
+        console.error(`Baseline has version ${baseline.version}, but this run has version ${report.version}.`);
+        process.exit(1);
+    }
+
+    let regressions = 0;
+    for (let result of report.benchmarks) {
+        let previous = baseline.benchmarks.find(b => b.name === result.name);
+        if (!previous)
+            continue;
+
+        let change = (result.median - previous.median) / previous.median;
+        let regressed = change > threshold;
+        if (regressed)
+            regressions += 1;
+
+        console.error(
+            `${regressed ? 'REGRESSED' : 'ok'}\t${result.name}\t`
+            + `${previous.median.toFixed(1)} -> ${result.median.toFixed(1)} ${report.unit} `
+            + `(${change >= 0 ? '+' : ''}${(change * 100).toFixed(1)}%)`
+        );
+    }
+
+    process.exit(regressions > 0 ? 1 : 0);
+}
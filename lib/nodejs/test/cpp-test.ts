@@ -1,4 +1,4 @@
 /* eslint no-process-exit:0 */
 import binding from '../../../binding';
-const result = binding.test();
-process.exit(result);
\ No newline at end of file
+const result = binding.test(process.argv.slice(2));
+process.exit(result);
@@ -0,0 +1,37 @@
+import { expect } from 'chai';
+import { describe } from 'razmin';
+import { RTCPeerConnection } from '..';
+import { negotiate, waitForStateChange } from './lib/pc';
+
+describe('RTCPeerConnection.create', it => {
+  it('resolves with a ready RTCPeerConnection', async () => {
+    const pc = await RTCPeerConnection.create({ iceServers: [] });
+    expect(pc).to.be.instanceOf(RTCPeerConnection);
+    expect(pc.signalingState).to.equal('stable');
+    expect(pc.getConfiguration().iceServers).to.deep.equal([]);
+    pc.close();
+    expect(pc.signalingState).to.equal('closed');
+  });
+
+  it('creates RTCPeerConnections that can connect', async () => {
+    const [pc1, pc2] = await Promise.all([RTCPeerConnection.create(), RTCPeerConnection.create()]);
+    [[pc1, pc2], [pc2, pc1]].forEach(([pcA, pcB]) => {
+      pcA.addEventListener('icecandidate', ({ candidate }) => candidate && pcB.addIceCandidate(candidate));
+    });
+    const channel = pc1.createDataChannel('create');
+    await negotiate(pc1, pc2);
+    await waitForStateChange(channel, 'open', { event: 'open', property: 'readyState' });
+    pc1.close();
+    pc2.close();
+  });
+
+  it('rejects an invalid configuration', async () => {
+    let error: any = null;
+    try {
+      await RTCPeerConnection.create({ iceServers: [{ urls: '' }] });
+    } catch (e) {
+      error = e;
+    }
+    expect(error).to.be.instanceOf(TypeError);
+  });
+});
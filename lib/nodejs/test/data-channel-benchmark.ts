@@ -0,0 +1,192 @@
+/* eslint no-process-exit:0 */
+import { performance } from 'perf_hooks';
+
+import { environment, listOption, networkOption, numberOption, percentile, writeReport } from './lib/benchmark';
+import { negotiateRTCPeerConnections, waitForStateChange } from './lib/pc';
+
+/**
+ * Measures data-channel throughput and latency over a loopback pair of
+ * RTCPeerConnections (see docs/benchmarks.md).
+ *
+ *   --duration <ms>         how long to send for in each case (default 2000)
+ *   --modes <list>          comma-separated subset of the modes below
+ *   --sizes <list>          comma-separated message sizes, in bytes
+ *   --channels <list>       comma-separated concurrent channel counts
+ *   --in-process            connect through memory instead of the kernel
+ *   --profile <name>        the same, under one of networkProfiles
+ *   --output <file>         write the JSON report to file instead of stdout
+ */
+
+const MODES: { [name: string]: RTCDataChannelInit } = {
+  'ordered-reliable': { ordered: true },
+  'unordered-reliable': { ordered: false },
+  'ordered-partial': { ordered: true, maxRetransmits: 0 },
+  'unordered-partial': { ordered: false, maxRetransmits: 0 }
+};
+
+const SIZES = [16, 256, 4096, 16384, 65536, 262144];
+
+const CHANNEL_COUNTS = [1, 8, 64];
+
+// Every message starts with the Float64 time at which it was sent.
+const MINIMUM_SIZE = 8;
+
+// Senders stop queueing once a channel's bufferedAmount reaches this many
+// bytes (or four messages, whichever is larger) and wait for it to drain.
+const HIGH_WATER_MARK = 1 << 20;
+
+// After sending stops, wait at most this long for the last messages.
+const DRAIN_TIMEOUT = 5000;
+
+function nextTick() {
+  return new Promise(resolve => setImmediate(resolve));
+}
+
+async function openChannels(mode: RTCDataChannelInit, channelCount: number) {
+  const localChannels: RTCDataChannel[] = [];
+  let remoteChannelsPromise: Promise<RTCDataChannel[]> | null = null;
+  const [pc1, pc2] = await negotiateRTCPeerConnections({
+    withPc1(pc1) {
+      for (let i = 0; i < channelCount; i++) {
+        localChannels.push(pc1.createDataChannel(`benchmark-${i}`, mode));
+      }
+    },
+    withPc2(pc2) {
+      remoteChannelsPromise = new Promise(resolve => {
+        const remoteChannels: RTCDataChannel[] = [];
+        pc2.addEventListener('datachannel', ({ channel }) => {
+          remoteChannels.push(channel);
+          if (remoteChannels.length === channelCount) {
+            resolve(remoteChannels);
+          }
+        });
+      });
+    }
+  });
+  try {
+    await Promise.all(localChannels.map(channel =>
+      waitForStateChange(channel, 'open', { event: 'open', property: 'readyState' })));
+    const remoteChannels = await remoteChannelsPromise!;
+    return { pc1, pc2, localChannels, remoteChannels };
+  } catch (error) {
+    pc1.close();
+    pc2.close();
+    throw error;
+  }
+}
+
+async function runCase(modeName: string, size: number, channelCount: number, duration: number) {
+  const { pc1, pc2, localChannels, remoteChannels } = await openChannels(MODES[modeName], channelCount);
+  try {
+    const latencies: number[] = [];
+    let receivedBytes = 0;
+    let lastReceivedAt = 0;
+
+    for (const channel of remoteChannels) {
+      channel.binaryType = 'arraybuffer';
+      channel.addEventListener('message', ({ data }) => {
+        lastReceivedAt = performance.now();
+        latencies.push(lastReceivedAt - new DataView(data).getFloat64(0));
+        receivedBytes += data.byteLength;
+      });
+    }
+
+    const payload = new ArrayBuffer(size);
+    const view = new DataView(payload);
+    const highWaterMark = Math.max(HIGH_WATER_MARK, 4 * size);
+    const maxMessagesPerTurn = Math.ceil(highWaterMark / size);
+    let sent = 0;
+
+    const start = performance.now();
+    while (performance.now() - start < duration) {
+      for (const channel of localChannels) {
+        for (let i = 0; i < maxMessagesPerTurn && channel.bufferedAmount < highWaterMark; i++) {
+          view.setFloat64(0, performance.now());
+          channel.send(payload);
+          sent++;
+        }
+      }
+      await nextTick();
+    }
+
+    const stoppedAt = performance.now();
+    while (latencies.length < sent && performance.now() - stoppedAt < DRAIN_TIMEOUT) {
+      await new Promise(resolve => setTimeout(resolve, 10));
+    }
+
+    const seconds = (Math.max(lastReceivedAt, stoppedAt) - start) / 1000;
+    latencies.sort((a, b) => a - b);
+    return {
+      mode: modeName,
+      ...MODES[modeName],
+      messageSize: size,
+      channels: channelCount,
+      sent,
+      received: latencies.length,
+      seconds,
+      messagesPerSecond: latencies.length / seconds,
+      megabytesPerSecond: receivedBytes / 1e6 / seconds,
+      latencyMs: {
+        p50: percentile(latencies, 0.5),
+        p99: percentile(latencies, 0.99),
+        p999: percentile(latencies, 0.999)
+      }
+    };
+  } finally {
+    pc1.close();
+    pc2.close();
+  }
+}
+
+function format(value: number | null, digits = 2) {
+  return value === null ? '-' : value.toFixed(digits);
+}
+
+async function main() {
+  const duration = numberOption('duration', 2000);
+  const modes = listOption('modes', Object.keys(MODES), String);
+  const sizes = listOption('sizes', SIZES, Number);
+  const channelCounts = listOption('channels', CHANNEL_COUNTS, Number);
+  const network = networkOption();
+
+  for (const mode of modes) {
+    if (!MODES[mode]) {
+      throw new Error(`Unknown mode "${mode}"; expected one of ${Object.keys(MODES).join(', ')}`);
+    }
+  }
+  for (const size of sizes) {
+    if (!(size >= MINIMUM_SIZE)) {
+      throw new Error(`Message sizes must be at least ${MINIMUM_SIZE} bytes`);
+    }
+  }
+
+  const results: any[] = [];
+  for (const mode of modes) {
+    for (const size of sizes) {
+      for (const channelCount of channelCounts) {
+        const result = await runCase(mode, size, channelCount, duration);
+        results.push(result);
+        console.error(
+          `${mode}\t${size} B\t${channelCount} ch\t`
+          + `${format(result.messagesPerSecond, 0)} msg/s\t${format(result.megabytesPerSecond)} MB/s\t`
+          + `p50 ${format(result.latencyMs.p50)} ms\tp99 ${format(result.latencyMs.p99)} ms\t`
+          + `p999 ${format(result.latencyMs.p999)} ms\t(${result.received}/${result.sent})`
+        );
+      }
+    }
+  }
+
+  writeReport({
+    version: 1,
+    benchmark: 'data-channel',
+    environment: environment(),
+    durationMs: duration,
+    network,
+    results
+  });
+}
+
+main().then(() => process.exit(0), error => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,276 @@
+/* eslint no-process-exit:0 */
+import { performance } from 'perf_hooks';
+
+import binding from '../../../binding';
+import { RTCAudioSource, RTCVideoSource } from '..';
+import {
+  AUDIO_PROCESSING_CONFIGS,
+  environment,
+  flagOption,
+  listOption,
+  networkOption,
+  numberOption,
+  option,
+  percentile,
+  writeReport
+} from './lib/benchmark';
+import { createRTCPeerConnections, negotiate, waitForStateChange } from './lib/pc';
+
+/**
+ * Measures memory and CPU per RTCPeerConnection by ramping up loopback
+ * connection pairs in steps (see docs/benchmarks.md). Run with --expose-gc so
+ * that memory is measured after a full collection.
+ *
+ *   --kinds <list>          comma-separated subset of data,audio,video
+ *   --steps <list>          comma-separated connection pair counts
+ *   --settle <ms>           how long to wait after each ramp (default 1000)
+ *   --window <ms>           how long to measure CPU at each step (default 3000)
+ *   --in-process            connect through memory instead of the kernel
+ *   --profile <name>        the same, under one of networkProfiles
+ *   --data-only             create the factory with dataOnly (with --kinds data)
+ *   --audio-processing <name>
+ *                           one of AUDIO_PROCESSING_CONFIGS (default "default")
+ *   --output <file>         write the JSON report to file instead of stdout
+ */
+
+const KINDS = ['data', 'audio', 'video'];
+
+const STEPS = [1, 5, 10, 25, 50];
+
+const VIDEO_WIDTH = 320;
+const VIDEO_HEIGHT = 240;
+const VIDEO_FRAME_RATE = 15;
+
+type Kind = 'data' | 'audio' | 'video';
+
+interface Pair {
+  pc1: RTCPeerConnection;
+  pc2: RTCPeerConnection;
+  stop(): void;
+}
+
+/**
+ * Feeds 10 ms of silence to every RTCAudioSource and a blank frame to every
+ * RTCVideoSource, the way an application would.
+ */
+class MediaFeeder {
+  readonly audioSources = new Set<any>();
+  readonly videoSources = new Set<any>();
+
+  private readonly audioTimer: NodeJS.Timeout;
+  private readonly videoTimer: NodeJS.Timeout;
+
+  constructor() {
+    const samples = new Int16Array(480);
+    const frame = {
+      width: VIDEO_WIDTH,
+      height: VIDEO_HEIGHT,
+      data: new Uint8ClampedArray(VIDEO_WIDTH * VIDEO_HEIGHT * 1.5)
+    };
+    this.audioTimer = setInterval(() => {
+      this.audioSources.forEach(source => source.onData({ samples, sampleRate: 48000 }));
+    }, 10);
+    this.videoTimer = setInterval(() => {
+      this.videoSources.forEach(source => source.onFrame(frame));
+    }, 1000 / VIDEO_FRAME_RATE);
+  }
+
+  stop() {
+    clearInterval(this.audioTimer);
+    clearInterval(this.videoTimer);
+  }
+}
+
+function wait(ms: number) {
+  return new Promise(resolve => setTimeout(resolve, ms));
+}
+
+function waitForConnected(pc: RTCPeerConnection) {
+  const connected = () => pc.iceConnectionState === 'connected' || pc.iceConnectionState === 'completed';
+  if (connected()) {
+    return Promise.resolve();
+  }
+  return new Promise<void>(resolve => {
+    pc.addEventListener('iceconnectionstatechange', function listener() {
+      if (connected()) {
+        pc.removeEventListener('iceconnectionstatechange', listener);
+        resolve();
+      }
+    });
+  });
+}
+
+async function createPair(kind: Kind, feeder: MediaFeeder): Promise<Pair> {
+  const [pc1, pc2] = createRTCPeerConnections();
+  let stop = () => {};
+  let ready: Promise<unknown>;
+
+  if (kind === 'data') {
+    const channel = pc1.createDataChannel('density');
+    ready = waitForStateChange(channel, 'open', { event: 'open', property: 'readyState' });
+  } else {
+    const source = kind === 'audio' ? new RTCAudioSource() : new RTCVideoSource();
+    const sources = kind === 'audio' ? feeder.audioSources : feeder.videoSources;
+    const track = source.createTrack();
+    pc1.addTrack(track);
+    sources.add(source);
+    stop = () => {
+      sources.delete(source);
+      track.stop();
+    };
+    ready = Promise.all([waitForConnected(pc1), waitForConnected(pc2)]);
+  }
+
+  try {
+    await negotiate(pc1, pc2);
+    await ready;
+    return { pc1, pc2, stop };
+  } catch (error) {
+    stop();
+    pc1.close();
+    pc2.close();
+    throw error;
+  }
+}
+
+function snapshot() {
+  if (typeof global.gc === 'function') {
+    global.gc();
+  }
+  const usage = binding.getResourceUsage();
+  return {
+    time: performance.now(),
+    cpu: process.cpuUsage(),
+    memory: process.memoryUsage(),
+    nativeHeap: usage.nativeHeap as number | null,
+    threads: usage.threads as { [name: string]: number } | null,
+    nativeExternal: usage.external as { [category: string]: number }
+  };
+}
+
+function cpuPercent(before: ReturnType<typeof snapshot>, after: ReturnType<typeof snapshot>) {
+  const elapsed = after.time - before.time;
+  const processTime = (after.cpu.user - before.cpu.user + after.cpu.system - before.cpu.system) / 1000;
+  const threads: { [name: string]: number } = {};
+  if (before.threads && after.threads) {
+    for (const name of Object.keys(after.threads)) {
+      threads[name] = (after.threads[name] - before.threads[name]) / elapsed * 100;
+    }
+  }
+  return { process: processTime / elapsed * 100, threads };
+}
+
+async function rampKind(kind: Kind, steps: number[], settle: number, window: number) {
+  const results: any[] = [];
+  const feeder = new MediaFeeder();
+  const pairs: Pair[] = [];
+  try {
+    for (const step of steps) {
+      const setupTimes: number[] = [];
+      while (pairs.length < step) {
+        const start = performance.now();
+        pairs.push(await createPair(kind, feeder));
+        setupTimes.push(performance.now() - start);
+      }
+
+      await wait(settle);
+      const before = snapshot();
+      await wait(window);
+      const after = snapshot();
+
+      setupTimes.sort((a, b) => a - b);
+      const result = {
+        kind,
+        connections: pairs.length,
+        setupMs: {
+          mean: setupTimes.length ? setupTimes.reduce((sum, time) => sum + time, 0) / setupTimes.length : null,
+          p50: percentile(setupTimes, 0.5),
+          p99: percentile(setupTimes, 0.99)
+        },
+        memory: {
+          rss: after.memory.rss,
+          nativeHeap: after.nativeHeap,
+          v8HeapUsed: after.memory.heapUsed,
+          v8HeapTotal: after.memory.heapTotal,
+          external: after.memory.external,
+          arrayBuffers: after.memory.arrayBuffers,
+          nativeExternal: after.nativeExternal
+        },
+        cpuPercent: cpuPercent(before, after)
+      };
+      results.push(result);
+
+      const mb = (bytes: number | null) => bytes === null ? '-' : `${(bytes / 1e6).toFixed(1)} MB`;
+      console.error(
+        `${kind}\t${result.connections} pairs\tsetup p50 ${result.setupMs.p50?.toFixed(1)} ms\t`
+        + `rss ${mb(result.memory.rss)}\tnative ${mb(result.memory.nativeHeap)}\tv8 ${mb(result.memory.v8HeapUsed)}\t`
+        + `cpu ${result.cpuPercent.process.toFixed(1)}%\t`
+        + Object.entries(result.cpuPercent.threads).map(([name, percent]) => `${name} ${percent.toFixed(1)}%`).join('\t')
+      );
+    }
+  } finally {
+    for (const pair of pairs) {
+      pair.stop();
+      pair.pc1.close();
+      pair.pc2.close();
+    }
+    feeder.stop();
+  }
+  return results;
+}
+
+async function main() {
+  const kinds = listOption('kinds', KINDS, String);
+  const steps = listOption('steps', STEPS, Number).sort((a, b) => a - b);
+  const settle = numberOption('settle', 1000);
+  const window = numberOption('window', 3000);
+  const dataOnly = flagOption('data-only');
+  const audioProcessing = option('audio-processing') ?? 'default';
+  if (!AUDIO_PROCESSING_CONFIGS[audioProcessing]) {
+    throw new Error(`Unknown audio processing "${audioProcessing}"; expected one of ${Object.keys(AUDIO_PROCESSING_CONFIGS).join(', ')}`);
+  }
+  const network = networkOption({ dataOnly, ...AUDIO_PROCESSING_CONFIGS[audioProcessing] });
+
+  for (const kind of kinds) {
+    if (!KINDS.includes(kind)) {
+      throw new Error(`Unknown kind "${kind}"; expected one of ${KINDS.join(', ')}`);
+    }
+  }
+  if (dataOnly && kinds.some(kind => kind !== 'data')) {
+    throw new Error('--data-only requires --kinds data');
+  }
+  if (typeof global.gc !== 'function') {
+    console.error('Run with --expose-gc for stable memory measurements.');
+  }
+
+  const baseline = snapshot();
+  const results: any[] = [];
+  for (const kind of kinds) {
+    results.push(...await rampKind(kind as Kind, steps, settle, window));
+    // Let closed connections tear down before ramping the next kind.
+    await wait(settle);
+  }
+
+  writeReport({
+    version: 1,
+    benchmark: 'density',
+    environment: environment(),
+    settleMs: settle,
+    windowMs: window,
+    network,
+    dataOnly,
+    audioProcessing,
+    video: { width: VIDEO_WIDTH, height: VIDEO_HEIGHT, frameRate: VIDEO_FRAME_RATE },
+    baseline: {
+      rss: baseline.memory.rss,
+      nativeHeap: baseline.nativeHeap,
+      v8HeapUsed: baseline.memory.heapUsed
+    },
+    results
+  });
+}
+
+main().then(() => process.exit(0), error => {
+  console.error(error);
+  process.exit(1);
+});
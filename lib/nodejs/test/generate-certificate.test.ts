@@ -0,0 +1,76 @@
+import { expect } from 'chai';
+import { describe } from 'razmin';
+import { RTCCertificate, RTCPeerConnection, getCertificatePoolStats, setCertificatePoolSize } from '..';
+import { negotiate, waitForStateChange } from './lib/pc';
+
+function wait(ms: number) {
+  return new Promise(resolve => setTimeout(resolve, ms));
+}
+
+describe('RTCPeerConnection.generateCertificate', it => {
+  it('generates ECDSA certificates', async () => {
+    const certificate = await RTCPeerConnection.generateCertificate({ name: 'ECDSA', namedCurve: 'P-256' } as EcKeyGenParams);
+    expect(certificate).to.be.instanceOf(RTCCertificate);
+    expect(certificate.expires).to.be.greaterThan(Date.now());
+    const [fingerprint] = certificate.getFingerprints();
+    expect(fingerprint.algorithm).to.equal('sha-256');
+    expect(fingerprint.value).to.match(/^([0-9a-f]{2}:)+[0-9a-f]{2}$/);
+  });
+
+  it('generates RSA certificates', async () => {
+    const certificate = await RTCPeerConnection.generateCertificate({
+      name: 'RSASSA-PKCS1-v1_5',
+      modulusLength: 2048,
+      publicExponent: new Uint8Array([1, 0, 1]),
+      hash: 'SHA-256'
+    } as RsaHashedKeyGenParams);
+    expect(certificate.expires).to.be.greaterThan(Date.now());
+  });
+
+  it('rejects unsupported algorithms', async () => {
+    let error: any = null;
+    try {
+      await RTCPeerConnection.generateCertificate({ name: 'ECDSA', namedCurve: 'P-521' } as EcKeyGenParams);
+    } catch (e) {
+      error = e;
+    }
+    expect(error).to.be.instanceOf(TypeError);
+  });
+
+  it('uses the certificates in the RTCConfiguration', async () => {
+    const certificate = await RTCPeerConnection.generateCertificate('ECDSA');
+    const pc1 = new RTCPeerConnection({ certificates: [certificate] });
+    const pc2 = new RTCPeerConnection();
+    [[pc1, pc2], [pc2, pc1]].forEach(([pcA, pcB]) => {
+      pcA.addEventListener('icecandidate', ({ candidate }) => candidate && pcB.addIceCandidate(candidate));
+    });
+    const channel = pc1.createDataChannel('certificates');
+    await negotiate(pc1, pc2);
+    await waitForStateChange(channel, 'open', { event: 'open', property: 'readyState' });
+    const { value } = certificate.getFingerprints()[0];
+    expect(pc1.localDescription!.sdp.toLowerCase()).to.include(`a=fingerprint:sha-256 ${value}`);
+    pc1.close();
+    pc2.close();
+  });
+});
+
+describe('setCertificatePoolSize', it => {
+  it('gives new RTCPeerConnections a pooled certificate', async () => {
+    setCertificatePoolSize(2);
+    try {
+      for (let i = 0; i < 100 && getCertificatePoolStats().available < 2; i++) {
+        await wait(10);
+      }
+      const before = getCertificatePoolStats();
+      expect(before.available).to.equal(2);
+
+      const pc = new RTCPeerConnection();
+      const after = getCertificatePoolStats();
+      expect(after.hits).to.equal(before.hits + 1);
+      pc.close();
+    } finally {
+      setCertificatePoolSize(0);
+    }
+    expect(getCertificatePoolStats().available).to.equal(0);
+  });
+});
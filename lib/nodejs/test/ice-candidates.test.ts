@@ -0,0 +1,33 @@
+import { expect } from 'chai';
+import { describe } from 'razmin';
+import { RTCPeerConnection } from '..';
+
+describe('icecandidate', it => {
+  it('delivers every gathered candidate, then null, in order', async () => {
+    const pc = new RTCPeerConnection();
+    const events: (RTCIceCandidate | null)[] = [];
+    const done = new Promise<void>(resolve => {
+      pc.addEventListener('icecandidate', ({ candidate }) => {
+        events.push(candidate);
+        if (!candidate) {
+          resolve();
+        }
+      });
+    });
+
+    pc.createDataChannel('candidates');
+    await pc.setLocalDescription(await pc.createOffer());
+    await done;
+
+    const candidates = events.slice(0, -1) as RTCIceCandidate[];
+    expect(candidates.length).to.be.greaterThan(0);
+    expect(events[events.length - 1]).to.equal(null);
+    for (const candidate of candidates) {
+      expect(candidate.candidate).to.match(/^candidate:/);
+      expect(candidate.sdpMid).to.equal('0');
+      expect(candidate.sdpMLineIndex).to.equal(0);
+      expect(pc.localDescription!.sdp).to.include(`a=${candidate.candidate}`);
+    }
+    pc.close();
+  });
+});
@@ -0,0 +1,52 @@
+import { expect } from 'chai';
+import { describe } from 'razmin';
+import { RTCPeerConnection } from '..';
+import { gatherCandidates } from './lib/pc';
+
+async function gather(configuration: any) {
+  const pc = new RTCPeerConnection(configuration);
+  const candidates = gatherCandidates(pc);
+  pc.createDataChannel('tuning');
+  await pc.setLocalDescription(await pc.createOffer());
+  const gathered = await candidates;
+  pc.close();
+  return gathered;
+}
+
+describe('RTCConfiguration ICE tuning', it => {
+  it('gathers no TCP or IPv6 candidates when they are disabled', async () => {
+    const candidates = await gather({ tcpCandidates: false, ipv6: false });
+    expect(candidates.length).to.be.greaterThan(0);
+    for (const { candidate } of candidates) {
+      expect(candidate).not.to.match(/ tcp /i);
+      expect(candidate.split(' ')[4]).not.to.include(':');
+    }
+  });
+
+  it('gathers at most one IPv4 host candidate without adapter enumeration', async () => {
+    // Without enumeration, the port allocator binds the any address, and only surfaces the default local address.
+    const candidates = await gather({ adapterEnumeration: false, tcpCandidates: false, ipv6: false });
+    const hosts = candidates.filter(({ candidate }) => / typ host/.test(candidate));
+    expect(hosts.length).to.be.at.most(1);
+  });
+
+  it('accepts ICE timing, and setConfiguration calls that omit or change it', () => {
+    const pc = new RTCPeerConnection(<any>{
+      iceCheckIntervalStrongConnectivity: 5000,
+      iceCheckMinInterval: 100,
+      iceUnwritableTimeout: 3000,
+      stunCandidateKeepaliveInterval: 25000,
+      iceRenomination: true,
+      surfaceIceCandidatesOnIceTransportTypeChanged: true,
+      linkLocalNetworks: false
+    });
+    // libwebrtc rejects changes to some of these, so omitting them must keep, not reset, them.
+    expect(() => pc.setConfiguration({ iceServers: [] })).not.to.throw();
+    expect(() => pc.setConfiguration(<any>{ iceCheckMinInterval: 200 })).not.to.throw();
+    pc.close();
+  });
+
+  it('rejects non-positive intervals', () => {
+    expect(() => new RTCPeerConnection(<any>{ iceUnwritableTimeout: 0 })).to.throw(TypeError);
+  });
+});
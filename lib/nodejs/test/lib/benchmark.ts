@@ -0,0 +1,98 @@
+import * as fs from 'fs';
+import * as os from 'os';
+
+import { PeerConnectionFactoryOptions, networkProfiles, setPeerConnectionFactoryOptions } from '../..';
+
+/**
+ * Helpers shared by the benchmark scripts in lib/nodejs/test. See
+ * docs/benchmarks.md.
+ */
+
+export function option(name: string): string | undefined {
+  const index = process.argv.indexOf(`--${name}`);
+  return index >= 0 ? process.argv[index + 1] : undefined;
+}
+
+export function numberOption(name: string, defaultValue: number): number {
+  const value = option(name);
+  return value === undefined ? defaultValue : Number(value);
+}
+
+export function listOption<T>(name: string, defaultValue: T[], parse: (value: string) => T): T[] {
+  const value = option(name);
+  return value === undefined ? defaultValue : value.split(',').map(parse);
+}
+
+export function flagOption(name: string): boolean {
+  return process.argv.includes(`--${name}`);
+}
+
+/**
+ * The audio processing configurations that --audio-processing chooses
+ * between.
+ */
+export const AUDIO_PROCESSING_CONFIGS: { [name: string]: PeerConnectionFactoryOptions } = {
+  // libwebrtc's defaults: everything on.
+  'default': {},
+  // An audio processing module with every submodule off.
+  'disabled': { echoCancellation: false, noiseSuppression: false, autoGainControl: false, highpassFilter: false },
+  // No audio processing module at all.
+  'none': { audioProcessing: false }
+};
+
+/**
+ * Applies --in-process, which connects RTCPeerConnections through memory
+ * instead of the kernel, and --profile, which does the same under one of
+ * networkProfiles. Call it before creating any RTCPeerConnections.
+ * @param options other PeerConnectionFactoryOptions to set along with these
+ * @returns the network to record in the report
+ */
+export function networkOption(options: PeerConnectionFactoryOptions = {}) {
+  const profile = option('profile');
+  if (profile !== undefined && !networkProfiles[profile]) {
+    throw new Error(`Unknown profile "${profile}"; expected one of ${Object.keys(networkProfiles).join(', ')}`);
+  }
+  const inProcess = flagOption('in-process') || profile !== undefined;
+  const conditions = profile === undefined ? {} : networkProfiles[profile];
+  setPeerConnectionFactoryOptions(inProcess
+    ? { ...options, inProcessNetwork: true, networkConditions: conditions }
+    : options);
+  return { inProcess, profile: profile ?? null, conditions };
+}
+
+/**
+ * Returns the p-th percentile (0 < p <= 1) of values using the nearest-rank
+ * method, or null if there are no values.
+ */
+export function percentile(sortedValues: number[], p: number): number | null {
+  if (sortedValues.length === 0) {
+    return null;
+  }
+  const rank = Math.ceil(p * sortedValues.length);
+  return sortedValues[Math.min(sortedValues.length, Math.max(rank, 1)) - 1];
+}
+
+export function environment() {
+  const cpus = os.cpus();
+  return {
+    node: process.version,
+    platform: process.platform,
+    arch: process.arch,
+    cpuModel: cpus.length ? cpus[0].model : null,
+    cpuCount: cpus.length,
+    totalMemory: os.totalmem()
+  };
+}
+
+/**
+ * Writes a report as JSON to the file named by --output, or to stdout.
+ */
+export function writeReport(report: object) {
+  const json = JSON.stringify(report, null, 2) + '\n';
+  const output = option('output');
+  if (output) {
+    fs.writeFileSync(output, json);
+  } else {
+    process.stdout.write(json);
+  }
+}
@@ -69,6 +69,14 @@ describe('MediaStream', it => {
     expect(stream.getTracks().length).to.equal(0);
     expect(stream.id).to.equal('testStreamId');
   });
+  it('getUserMedia accepts audio processing constraints', async () => {
+    const stream = await getUserMedia({
+      audio: { echoCancellation: false, noiseSuppression: false, autoGainControl: true }
+    });
+    expect(stream.getAudioTracks().length).to.equal(1);
+    stream.getTracks().forEach(track => track.stop());
+  });
+
   it('.clone', async () => {
     let stream1 = await getRemoteMediaStream();
     var stream2 = stream1.clone();
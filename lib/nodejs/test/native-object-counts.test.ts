@@ -0,0 +1,25 @@
+import { describe } from 'razmin';
+import { expect } from 'chai';
+import { getNativeObjectCounts, RTCPeerConnection } from '..';
+
+describe('getNativeObjectCounts', it => {
+  it('counts running RTCPeerConnections until they are closed', async () => {
+    const before = getNativeObjectCounts().objects.RTCPeerConnection?.running ?? 0;
+
+    const pc = new RTCPeerConnection();
+    const { objects } = getNativeObjectCounts();
+    expect(objects.RTCPeerConnection.running).to.equal(before + 1);
+    expect(objects.RTCPeerConnection.live).to.be.at.least(objects.RTCPeerConnection.running);
+
+    pc.close();
+    await new Promise(resolve => setTimeout(resolve, 100));
+    expect(getNativeObjectCounts().objects.RTCPeerConnection.running).to.equal(before);
+  });
+
+  it('reports pending events and external memory', () => {
+    const { pendingEvents, external } = getNativeObjectCounts();
+    expect(pendingEvents).to.be.a('number');
+    expect(external.total).to.equal(
+      external.videoFrames + external.audioData + external.dataChannelMessages + external.buffers);
+  });
+});
@@ -0,0 +1,260 @@
+import { expect } from 'chai';
+import { describe } from 'razmin';
+import {
+  RTCAudioSink,
+  RTCAudioSource,
+  RTCPeerConnection,
+  getIceCandidatePoolStats,
+  networkProfiles,
+  setPeerConnectionFactoryOptions
+} from '..';
+import { gatherCandidates, negotiateRTCPeerConnections, waitForStateChange } from './lib/pc';
+
+describe('setPeerConnectionFactoryOptions', it => {
+  it('accepts networks, cacheNetworks and prebindSockets', () => {
+    setPeerConnectionFactoryOptions({ networks: ['lo', '127.0.0.1'], cacheNetworks: true, prebindSockets: 4 });
+    setPeerConnectionFactoryOptions({});
+  });
+
+  it('accepts an ICE candidate pool', () => {
+    setPeerConnectionFactoryOptions({
+      iceCandidatePoolSize: 2,
+      iceCandidatePoolServers: [{ urls: 'stun:127.0.0.1:3478' }],
+      iceCandidatePoolPortRange: { min: 10000, max: 20000 }
+    });
+    setPeerConnectionFactoryOptions({});
+  });
+
+  it('accepts batchUdp and UDP buffer sizes', () => {
+    setPeerConnectionFactoryOptions({ batchUdp: true, udpReceiveBufferSize: 1 << 21, udpSendBufferSize: 1 << 21 });
+    setPeerConnectionFactoryOptions({});
+  });
+
+  it('accepts an in-process network and its conditions', () => {
+    setPeerConnectionFactoryOptions({
+      inProcessNetwork: true,
+      networkConditions: { delay: 20, jitter: 5, loss: 0.01, bandwidth: 1e6, queueLength: 100 }
+    });
+    setPeerConnectionFactoryOptions({});
+  });
+
+  it('accepts dataOnly and playoutOnlyForSinks', () => {
+    setPeerConnectionFactoryOptions({ dataOnly: true });
+    setPeerConnectionFactoryOptions({ playoutOnlyForSinks: true });
+    setPeerConnectionFactoryOptions({});
+  });
+
+  it('accepts audio processing options', () => {
+    setPeerConnectionFactoryOptions({ audioProcessing: false });
+    setPeerConnectionFactoryOptions({
+      echoCancellation: false,
+      noiseSuppression: false,
+      autoGainControl: false,
+      highpassFilter: false
+    });
+    setPeerConnectionFactoryOptions({});
+  });
+
+  it('accepts every network profile', () => {
+    expect(Object.keys(networkProfiles)).to.include.members(['lossy-wifi', 'lte', 'satellite']);
+    for (const conditions of Object.values(networkProfiles)) {
+      setPeerConnectionFactoryOptions({ inProcessNetwork: true, networkConditions: conditions });
+    }
+    setPeerConnectionFactoryOptions({});
+  });
+
+  it('rejects invalid options', () => {
+    expect(() => setPeerConnectionFactoryOptions(<any>{ networks: 'eth0' })).to.throw(TypeError);
+    expect(() => setPeerConnectionFactoryOptions({ prebindSockets: 1000 })).to.throw(TypeError);
+    expect(() => setPeerConnectionFactoryOptions({ iceCandidatePoolSize: 1000 })).to.throw(TypeError);
+    expect(() => setPeerConnectionFactoryOptions({ udpSendBufferSize: -1 })).to.throw(TypeError);
+    expect(() => setPeerConnectionFactoryOptions({ networkConditions: { loss: 2 } })).to.throw(TypeError);
+    expect(() => setPeerConnectionFactoryOptions({ networkConditions: { delay: -1 } })).to.throw(TypeError);
+    setPeerConnectionFactoryOptions({});
+  });
+});
+
+describe('getIceCandidatePoolStats', it => {
+  it('counts RTCPeerConnections that could take from the pool', async () => {
+    // The options only apply to a new factory, which earlier tests may keep alive.
+    setPeerConnectionFactoryOptions({ iceCandidatePoolSize: 1 });
+    try {
+      const pc = new RTCPeerConnection();
+      const candidates = gatherCandidates(pc);
+      pc.createDataChannel('pool');
+      await pc.setLocalDescription(await pc.createOffer());
+      expect((await candidates).length).to.be.greaterThan(0);
+      const stats = getIceCandidatePoolStats();
+      if (stats.size) {
+        expect(stats.size).to.equal(1);
+        expect(stats.hits + stats.misses).to.be.greaterThan(0);
+        // A warm allocator raises the pool size internally, but getConfiguration reports the one asked for.
+        expect(pc.getConfiguration().iceCandidatePoolSize).to.equal(0);
+      }
+      pc.close();
+    } finally {
+      setPeerConnectionFactoryOptions({});
+    }
+  });
+
+  it('lets setConfiguration change ICE servers after setLocalDescription with a pool hit', async () => {
+    setPeerConnectionFactoryOptions({ iceCandidatePoolSize: 1 });
+    try {
+      // The first RTCPeerConnection may create the factory, and with it the pool, so give the pool time to warm.
+      new RTCPeerConnection().close();
+      await new Promise(resolve => setTimeout(resolve, 100));
+      const before = getIceCandidatePoolStats();
+      const pc = new RTCPeerConnection();
+      if (before.available) {
+        expect(getIceCandidatePoolStats().hits).to.be.greaterThan(before.hits);
+      }
+      pc.createDataChannel('pool');
+      await pc.setLocalDescription(await pc.createOffer());
+      pc.setConfiguration({ iceServers: [{ urls: 'stun:127.0.0.1:3478' }] });
+      expect(pc.getConfiguration().iceCandidatePoolSize).to.equal(0);
+      expect(() => pc.setConfiguration({ iceCandidatePoolSize: 2 })).to.throw();
+      pc.close();
+    } finally {
+      setPeerConnectionFactoryOptions({});
+    }
+  });
+});
+
+async function sendOverDataChannel(message: string) {
+  let channel1: RTCDataChannel | null = null;
+  let channel2: Promise<RTCDataChannel> | null = null;
+  const [pc1, pc2] = await negotiateRTCPeerConnections({
+    withPc1(pc1) {
+      channel1 = pc1.createDataChannel('factory-options');
+    },
+    withPc2(pc2) {
+      channel2 = new Promise(resolve => pc2.addEventListener('datachannel', ({ channel }) => resolve(channel)));
+    }
+  });
+  try {
+    await waitForStateChange(channel1!, 'open', { event: 'open', property: 'readyState' });
+    const channel = await channel2!;
+    const received = new Promise(resolve => channel.addEventListener('message', ({ data }) => resolve(data)));
+    channel1!.send(message);
+    return await received;
+  } finally {
+    pc1.close();
+    pc2.close();
+  }
+}
+
+describe('inProcessNetwork', it => {
+  it('connects RTCPeerConnections in the same process', async () => {
+    // The options only apply to a new factory, which earlier tests may keep alive.
+    setPeerConnectionFactoryOptions({ inProcessNetwork: true, networkConditions: { delay: 5 } });
+    try {
+      expect(await sendOverDataChannel('hello')).to.equal('hello');
+    } finally {
+      setPeerConnectionFactoryOptions({});
+    }
+  });
+});
+
+describe('networkProfiles', it => {
+  it('delays the in-process network by the profile\'s round trip', async () => {
+    // The options only apply to a new factory, which earlier tests may keep alive.
+    setPeerConnectionFactoryOptions({ inProcessNetwork: true, networkConditions: networkProfiles['satellite'] });
+    let channel1: RTCDataChannel | null = null;
+    let channel2: Promise<RTCDataChannel> | null = null;
+    try {
+      const [pc1, pc2] = await negotiateRTCPeerConnections({
+        withPc1(pc1) {
+          channel1 = pc1.createDataChannel('profile');
+        },
+        withPc2(pc2) {
+          channel2 = new Promise(resolve => pc2.addEventListener('datachannel', ({ channel }) => resolve(channel)));
+        }
+      });
+      try {
+        await waitForStateChange(channel1!, 'open', { event: 'open', property: 'readyState' });
+        const echo = await channel2!;
+        echo.addEventListener('message', ({ data }) => echo.send(data));
+
+        // The fastest of a few round trips, so that a retransmission after a loss does not count.
+        const roundTrips: number[] = [];
+        let pong: (() => void) | null = null;
+        channel1!.addEventListener('message', () => pong?.());
+        for (let i = 0; i < 3; i++) {
+          const start = Date.now();
+          const received = new Promise<void>(resolve => { pong = resolve; });
+          channel1!.send(`ping ${i}`);
+          await received;
+          roundTrips.push(Date.now() - start);
+        }
+        // An earlier test may keep a factory on the real network alive; the in-process network's host is 10.0.0.1.
+        if (pc1.localDescription!.sdp.includes('10.0.0.1')) {
+          const { delay, jitter } = networkProfiles['satellite'];
+          expect(Math.min(...roundTrips)).to.be.at.least(2 * (delay! - 3 * jitter!));
+        }
+      } finally {
+        pc1.close();
+        pc2.close();
+      }
+    } finally {
+      setPeerConnectionFactoryOptions({});
+    }
+  });
+});
+
+describe('dataOnly', it => {
+  it('still negotiates RTCDataChannels', async () => {
+    setPeerConnectionFactoryOptions({ dataOnly: true });
+    try {
+      expect(await sendOverDataChannel('hello')).to.equal('hello');
+    } finally {
+      setPeerConnectionFactoryOptions({});
+    }
+  });
+});
+
+function nextData(sink: RTCAudioSink) {
+  return new Promise(resolve => { sink.ondata = resolve; });
+}
+
+describe('playoutOnlyForSinks', it => {
+  it('delivers remote audio to RTCAudioSinks, and resumes for a new one', async () => {
+    // The options only apply to a new factory, which earlier tests may keep alive.
+    setPeerConnectionFactoryOptions({ playoutOnlyForSinks: true });
+    const source = new RTCAudioSource();
+    const track = source.createTrack();
+    // 10 ms of 16-bit mono silence, pushed continuously so that there is always something to decode.
+    const data = { samples: new Int16Array(480), sampleRate: 48000, bitsPerSample: 16, channelCount: 1, numberOfFrames: 480 };
+    const interval = setInterval(() => source.onData(data), 10);
+    let remoteTrack: Promise<MediaStreamTrack> | null = null;
+    try {
+      const [pc1, pc2] = await negotiateRTCPeerConnections({
+        withPc1(pc1) {
+          pc1.addTrack(track);
+        },
+        withPc2(pc2) {
+          remoteTrack = new Promise(resolve => pc2.addEventListener('track', ({ track }) => resolve(track)));
+        }
+      });
+      try {
+        await waitForStateChange(pc1, 'connected', { event: 'connectionstatechange', property: 'connectionState' });
+        const remote = await remoteTrack!;
+
+        const sink1 = new RTCAudioSink(remote);
+        await nextData(sink1);
+        sink1.stop();
+
+        // Playout paused with the last sink; attaching another resumes it.
+        const sink2 = new RTCAudioSink(remote);
+        await nextData(sink2);
+        sink2.stop();
+      } finally {
+        pc1.close();
+        pc2.close();
+      }
+    } finally {
+      clearInterval(interval);
+      track.stop();
+      setPeerConnectionFactoryOptions({});
+    }
+  });
+});
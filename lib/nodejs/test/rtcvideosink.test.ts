@@ -27,4 +27,46 @@ describe('RTCVideoSink', it => {
     expect(sink.stopped).to.be.true;
     track.stop();
   });
+
+  it('coalesces undelivered frames when coalesceFrames is set', async () => {
+    const source = new RTCVideoSource();
+    const track = source.createTrack();
+    const sink = new RTCVideoSink(track, { coalesceFrames: true });
+    let frames = 0;
+    sink.onframe = () => frames++;
+
+    // Nothing is delivered until we yield, so only the last of these survives.
+    for (let i = 0; i < 10; i++)
+      source.onFrame(new I420Frame(160, 120));
+
+    await new Promise(resolve => setTimeout(resolve, 100));
+    expect(frames).to.equal(1);
+    expect(sink.getQueueMetrics().dropped).to.equal(9);
+
+    sink.stop();
+    track.stop();
+  });
+
+  it('reports queue metrics', async () => {
+    const source = new RTCVideoSource();
+    const track = source.createTrack();
+    const sink = new RTCVideoSink(track);
+    let frames = 0;
+    sink.onframe = () => frames++;
+
+    for (let i = 0; i < 3; i++)
+      source.onFrame(new I420Frame(160, 120));
+    expect(sink.getQueueMetrics().depth).to.equal(3);
+
+    await new Promise(resolve => setTimeout(resolve, 100));
+    const metrics = sink.getQueueMetrics();
+    expect(frames).to.equal(3);
+    expect(metrics.depth).to.equal(0);
+    expect(metrics.highWaterDepth).to.equal(3);
+    expect(metrics.dispatched).to.equal(3);
+    expect(metrics.latency.buckets.reduce((sum, { count }) => sum + count, 0)).to.equal(3);
+
+    sink.stop();
+    track.stop();
+  });
 });
@@ -0,0 +1,36 @@
+import { expect } from 'chai';
+import { describe } from 'razmin';
+import { RTCPeerConnection } from '..';
+import { gatherCandidates } from './lib/pc';
+
+describe('RTCPeerConnection state', it => {
+  it('localDescription includes candidates gathered after setLocalDescription', async () => {
+    const pc = new RTCPeerConnection({ iceServers: [] });
+    pc.createDataChannel('snapshot');
+    const gathered = gatherCandidates(pc);
+    await pc.setLocalDescription(await pc.createOffer());
+    expect(pc.signalingState).to.equal('have-local-offer');
+    expect(pc.pendingLocalDescription!.type).to.equal('offer');
+    expect(pc.currentLocalDescription).to.equal(null);
+
+    const candidates = await gathered;
+    expect(pc.iceGatheringState).to.equal('complete');
+    for (const { candidate } of candidates) {
+      expect(pc.localDescription!.sdp).to.contain(candidate);
+    }
+    pc.close();
+  });
+
+  it('reports closed states once closed', () => {
+    const pc = new RTCPeerConnection({ iceServers: [] });
+    expect(pc.signalingState).to.equal('stable');
+    expect(pc.iceConnectionState).to.equal('new');
+    expect(pc.connectionState).to.equal('new');
+    expect(pc.iceGatheringState).to.equal('new');
+    pc.close();
+    expect(pc.signalingState).to.equal('closed');
+    expect(pc.iceConnectionState).to.equal('closed');
+    expect(pc.connectionState).to.equal('closed');
+    expect(pc.localDescription).to.equal(null);
+  });
+});
@@ -0,0 +1,12 @@
+import * as native from '../../binding';
+
+/**
+ * Start writing a Chrome trace-event JSON file of libwebrtc's and wrtc's trace
+ * events. Throws if already tracing.
+ */
+export const startTracing: (path: string) => void = native.startTracing;
+
+/**
+ * Stop tracing and finish writing the file.
+ */
+export const stopTracing: () => void = native.stopTracing;
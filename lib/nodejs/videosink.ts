@@ -1,16 +1,26 @@
 import { inherits } from 'util';
 import * as native from '../../binding';
 import { EventTarget } from './eventtarget';
+import type { EventQueueMetrics } from './eventloop';
 export const RTCVideoSink: typeof RTCVideoSinkT = native.RTCVideoSink;
 export type RTCVideoSink = typeof RTCVideoSinkT;
 
+export interface RTCVideoSinkInit {
+    /**
+     * Deliver only the newest frame when frames arrive faster than they can
+     * be dispatched, dropping any older frames not yet delivered.
+     */
+    coalesceFrames?: boolean;
+}
+
 export interface RTCVideoSinkEvent extends Event {
     frame: any;
 }
 
 declare class RTCVideoSinkT extends EventTarget {
-    constructor(track: MediaStreamTrack);
+    constructor(track: MediaStreamTrack, init?: RTCVideoSinkInit);
     stop(): void;
+    getQueueMetrics(): EventQueueMetrics;
     readonly stopped: boolean;
     onframe: (ev: RTCVideoSinkEvent) => void;
 }
@@ -0,0 +1,388 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#ifdef NODE_WEBRTC_BENCHMARKS
+
+#include "src/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <webrtc/api/data_channel_interface.h>
+#include <webrtc/api/scoped_refptr.h>
+#include <webrtc/api/stats/rtc_stats_report.h>
+#include <webrtc/api/stats/rtcstats_objects.h>
+#include <webrtc/api/video/i420_buffer.h>
+#include <webrtc/rtc_base/async_packet_socket.h>
+#include <webrtc/rtc_base/ip_address.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/socket_address.h>
+#include <webrtc/rtc_base/third_party/sigslot/sigslot.h>
+#include <webrtc/rtc_base/thread.h>
+
+#include "src/converters.h"
+#include "src/converters/arguments.h"
+#include "src/converters/napi.h"
+#include "src/converters/webrtc.h"
+#include "src/dictionaries/node_webrtc/rtc_on_data_event_dict.h"
+#include "src/dictionaries/webrtc/rtc_stats_report.h"
+#include "src/dictionaries/webrtc/video_frame_buffer.h"
+#include "src/functional/maybe.h"
+#include "src/node/event_queue.h"
+#include "src/node/events.h"
+#include "src/utilities/bidi_map.h"
+#include "src/webrtc/batching_packet_socket_factory.h"
+
+namespace node_webrtc {
+
+namespace {
+
+/**
+ * Bump this whenever the shape of the JSON output changes.
+ */
+const int kSchemaVersion = 1;
+
+/**
+ * Each benchmark reports kSamples samples. Every sample times a batch of
+ * iterations that takes at least kMinSampleTime, so that timer resolution
+ * does not dominate cheap operations.
+ */
+const size_t kSamples = 30;
+const std::chrono::microseconds kMinSampleTime(500);
+const uint64_t kMaxBatchSize = 1 << 24;
+
+typedef std::chrono::steady_clock Clock;
+
+struct BenchmarkTarget {};
+
+struct BenchmarkResult {
+  std::string name;
+  uint64_t iterations;
+  std::vector<double> samples;
+};
+
+template <typename F>
+double TimeBatch(F& f, uint64_t batchSize) {
+  auto start = Clock::now();
+  for (uint64_t i = 0; i < batchSize; i++) {
+    f();
+  }
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+template <typename F>
+BenchmarkResult Run(const std::string& name, F f) {
+  uint64_t batchSize = 1;
+  while (batchSize < kMaxBatchSize
+      && TimeBatch(f, batchSize) < std::chrono::duration<double, std::nano>(kMinSampleTime).count()) {
+    batchSize *= 2;
+  }
+
+  BenchmarkResult result = { name, 0, {} };
+  for (size_t i = 0; i < kSamples; i++) {
+    result.samples.push_back(TimeBatch(f, batchSize) / batchSize);
+    result.iterations += batchSize;
+  }
+  std::sort(result.samples.begin(), result.samples.end());
+  return result;
+}
+
+std::string ToJson(const std::vector<BenchmarkResult>& results) {
+  std::ostringstream json;
+  json << std::fixed << std::setprecision(3);
+  json << "{\n  \"version\": " << kSchemaVersion << ",\n  \"unit\": \"ns\",\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& result = results[i];
+    const auto& samples = result.samples;
+    double sum = 0;
+    for (auto sample : samples) {
+      sum += sample;
+    }
+    json << (i ? "," : "") << "\n    {"
+        << "\"name\": \"" << result.name << "\", "
+        << "\"iterations\": " << result.iterations << ", "
+        << "\"samples\": " << samples.size() << ", "
+        << "\"min\": " << samples.front() << ", "
+        << "\"median\": " << samples[samples.size() / 2] << ", "
+        << "\"mean\": " << sum / samples.size() << ", "
+        << "\"p90\": " << samples[samples.size() * 9 / 10] << ", "
+        << "\"max\": " << samples.back() << "}";
+  }
+  json << "\n  ]\n}\n";
+  return json.str();
+}
+
+rtc::scoped_refptr<webrtc::RTCStatsReport> CreateStatsReport() {
+  auto report = webrtc::RTCStatsReport::Create(0);
+  for (int i = 0; i < 8; i++) {
+    auto id = std::to_string(i);
+
+    std::unique_ptr<webrtc::RTCInboundRTPStreamStats> inbound(new webrtc::RTCInboundRTPStreamStats("RTCInboundRTPStream_" + id, 0));
+    inbound->ssrc = static_cast<uint32_t>(i);
+    inbound->kind = "audio";
+    inbound->packets_received = 1000;
+    inbound->bytes_received = 160000;
+    inbound->jitter = 0.002;
+    report->AddStats(std::move(inbound));
+
+    std::unique_ptr<webrtc::RTCTransportStats> transport(new webrtc::RTCTransportStats("RTCTransport_" + id, 0));
+    transport->bytes_sent = 160000;
+    transport->bytes_received = 160000;
+    transport->dtls_state = "connected";
+    report->AddStats(std::move(transport));
+  }
+  return report;
+}
+
+/**
+ * A pair of UDP sockets on the loopback interface, owned by a network thread
+ * of their own, like PeerConnectionFactory's worker thread.
+ */
+class UdpLoopback: public sigslot::has_slots<> {
+ public:
+  explicit UdpLoopback(bool batch): _thread(rtc::Thread::CreateWithSocketServer()) {
+    _thread->SetName("benchmark:network", nullptr);
+    _thread->Start();
+    _thread->Invoke<void>(RTC_FROM_HERE, [this, batch]() {
+      _factory.reset(new BatchingPacketSocketFactory(_thread.get(), batch, 1 << 21, 1 << 21));
+      rtc::SocketAddress loopback(rtc::IPAddress(0x7f000001), 0);
+      _sender.reset(_factory->CreateUdpSocket(loopback, 0, 0));
+      _receiver.reset(_factory->CreateUdpSocket(loopback, 0, 0));
+      _receiver->SignalReadPacket.connect(this, &UdpLoopback::OnReadPacket);
+    });
+  }
+
+  ~UdpLoopback() override {
+    _thread->Invoke<void>(RTC_FROM_HERE, [this]() {
+      _sender = nullptr;
+      _receiver = nullptr;
+      _factory = nullptr;
+    });
+    _thread->Stop();
+  }
+
+  /**
+   * Send count packets from one socket to the other in a single task, and
+   * wait for them to arrive. Each round tags its packets, so that packets
+   * arriving after a previous round timed out do not count towards this one.
+   */
+  void SendAndReceive(size_t count) {
+    uint32_t round;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      round = ++_round;
+      _expected = count;
+      _received = 0;
+    }
+    _thread->PostTask(RTC_FROM_HERE, [this, count, round]() {
+      memcpy(_payload, &round, sizeof(round));
+      rtc::PacketOptions options;
+      auto address = _receiver->GetLocalAddress();
+      for (size_t i = 0; i < count; i++) {
+        _sender->SendTo(_payload, sizeof(_payload), address, options);
+      }
+    });
+    // Whatever the kernel dropped costs one timeout, not every round after it.
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait_for(lock, std::chrono::milliseconds(100), [this]() { return _received >= _expected; });
+  }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket*, const char* data, size_t size, const rtc::SocketAddress&, const int64_t&) {
+    uint32_t round;
+    if (size < sizeof(round)) {
+      return;
+    }
+    memcpy(&round, data, sizeof(round));
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (round == _round && ++_received >= _expected) {
+      _condition.notify_one();
+    }
+  }
+
+  std::unique_ptr<rtc::Thread> _thread;
+  std::unique_ptr<BatchingPacketSocketFactory> _factory;
+  std::unique_ptr<rtc::AsyncPacketSocket> _sender;
+  std::unique_ptr<rtc::AsyncPacketSocket> _receiver;
+  char _payload[1200] = {};  // Only used on _thread
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  uint32_t _round = 0;  // Guarded by _mutex
+  uint64_t _expected = 0;  // Guarded by _mutex
+  uint64_t _received = 0;  // Guarded by _mutex
+};
+
+typedef std::function<BenchmarkResult(const std::string&)> BenchmarkFunction;
+
+std::vector<std::pair<std::string, BenchmarkFunction>> CreateBenchmarks(Napi::Env env) {
+  std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+
+  auto add = [&benchmarks](const std::string& name, BenchmarkFunction function) {
+    benchmarks.emplace_back(name, std::move(function));
+  };
+
+  add("event_queue/enqueue_dequeue", [](const std::string& name) {
+    EventQueue<BenchmarkTarget> queue;
+    return Run(name, [&queue]() {
+      queue.Enqueue(Event<BenchmarkTarget>::Create());
+      queue.Dequeue();
+    });
+  });
+
+  add("event_queue/enqueue_dequeue_x64", [](const std::string& name) {
+    EventQueue<BenchmarkTarget> queue;
+    return Run(name, [&queue]() {
+      for (int i = 0; i < 64; i++) {
+        queue.Enqueue(Event<BenchmarkTarget>::Create());
+      }
+      while (queue.Dequeue()) {}
+    });
+  });
+
+  add("bidi_map/compute_if_absent_hit", [](const std::string& name) {
+    BidiMap<int, int> map;
+    for (int i = 0; i < 1024; i++) {
+      map.set(i, -i);
+    }
+    int key = 0;
+    return Run(name, [&map, &key]() {
+      map.computeIfAbsent(key++ % 1024, []() { return 0; });
+    });
+  });
+
+  add("bidi_map/compute_if_absent_miss", [](const std::string& name) {
+    BidiMap<int, int> map;
+    int key = 0;
+    return Run(name, [&map, &key]() {
+      if (key % 1024 == 0) {
+        map.clear();
+      }
+      map.computeIfAbsent(key, [key]() { return -key; });
+      key++;
+    });
+  });
+
+  add("video_frame_buffer/i420_to_napi_640x480", [env](const std::string& name) {
+    auto buffer = webrtc::I420Buffer::Create(640, 480);
+    return Run(name, [env, &buffer]() {
+      Napi::HandleScope scope(env);
+      From<Napi::Value>(std::make_pair(env, static_cast<const webrtc::I420BufferInterface*>(buffer.get())));
+    });
+  });
+
+  add("video_frame_buffer/i420_to_napi_640x480_padded", [env](const std::string& name) {
+    auto buffer = webrtc::I420Buffer::Create(640, 480, 672, 336, 336);
+    return Run(name, [env, &buffer]() {
+      Napi::HandleScope scope(env);
+      From<Napi::Value>(std::make_pair(env, static_cast<const webrtc::I420BufferInterface*>(buffer.get())));
+    });
+  });
+
+  add("rtc_on_data_event_dict/from_napi", [env](const std::string& name) {
+    Napi::HandleScope scope(env);
+    auto object = Napi::Object::New(env);
+    object.Set("samples", Napi::Int16Array::New(env, 480));
+    object.Set("sampleRate", 48000);
+    auto value = Napi::Persistent(object.As<Napi::Value>());
+    return Run(name, [env, &value]() {
+      Napi::HandleScope scope(env);
+      auto maybeDict = From<RTCOnDataEventDict>(value.Value());
+      if (maybeDict.IsValid()) {
+        delete[] maybeDict.UnsafeFromValid().samples;
+      }
+    });
+  });
+
+  add("rtc_on_data_event_dict/to_napi", [env](const std::string& name) {
+    return Run(name, [env]() {
+      Napi::HandleScope scope(env);
+      RTCOnDataEventDict dict = { new uint8_t[960](), 16, 48000, 1, MakeJust<uint16_t>(480) };
+      From<Napi::Value>(std::make_pair(env, dict));
+    });
+  });
+
+  add("rtc_stats_report/to_napi", [env](const std::string& name) {
+    auto report = CreateStatsReport();
+    return Run(name, [env, &report]() {
+      Napi::HandleScope scope(env);
+      From<Napi::Value>(std::make_pair(env, report));
+    });
+  });
+
+  add("data_channel/message_text_16b", [env](const std::string& name) {
+    webrtc::DataBuffer buffer(std::string(16, 'x'));
+    return Run(name, [env, &buffer]() {
+      Napi::HandleScope scope(env);
+      From<Napi::Value>(std::make_pair(env, buffer));
+    });
+  });
+
+  add("data_channel/message_binary_16kb", [env](const std::string& name) {
+    webrtc::DataBuffer buffer(rtc::CopyOnWriteBuffer(16384), true);
+    return Run(name, [env, &buffer]() {
+      Napi::HandleScope scope(env);
+      From<Napi::Value>(std::make_pair(env, buffer));
+    });
+  });
+
+  add("udp_socket/loopback_basic_x64", [](const std::string& name) {
+    UdpLoopback loopback(false);
+    return Run(name, [&loopback]() {
+      loopback.SendAndReceive(64);
+    });
+  });
+
+  add("udp_socket/loopback_batched_x64", [](const std::string& name) {
+    UdpLoopback loopback(true);
+    return Run(name, [&loopback]() {
+      loopback.SendAndReceive(64);
+    });
+  });
+
+  return benchmarks;
+}
+
+}  // namespace
+
+Napi::Value Benchmark::BenchmarkImpl(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, maybeFilter, Maybe<std::string>)
+  auto filter = maybeFilter.FromMaybe("");
+
+  std::vector<BenchmarkResult> results;
+  for (const auto& benchmark : CreateBenchmarks(env)) {
+    if (benchmark.first.find(filter) != std::string::npos) {
+      results.push_back(benchmark.second(benchmark.first));
+    }
+  }
+
+  CONVERT_OR_THROW_AND_RETURN_NAPI(env, ToJson(results), value, Napi::Value)
+  return value;
+}
+
+void Benchmark::Init(Napi::Env env, Napi::Object exports) {
+  auto func = Napi::Function::New(env, BenchmarkImpl);
+  exports.Set("benchmark", func);
+}
+
+}  // namespace node_webrtc
+
+#endif  // NODE_WEBRTC_BENCHMARKS
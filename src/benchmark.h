@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#ifdef NODE_WEBRTC_BENCHMARKS
+
+#pragma once
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * Benchmark exposes `benchmark([filter])`, which times native hot paths in
+ * isolation and returns the results as a JSON string. The format is stable
+ * (see docs/benchmarks.md) so that results can be tracked across releases.
+ */
+class Benchmark {
+ public:
+  static void Init(Napi::Env, Napi::Object);
+
+ private:
+  static Napi::Value BenchmarkImpl(const Napi::CallbackInfo&);
+};
+
+}  // namespace node_webrtc
+
+#endif  // NODE_WEBRTC_BENCHMARKS
@@ -16,6 +16,7 @@
 #include "src/interfaces/media_stream_track.h"
 #include "src/interfaces/rtc_audio_sink.h"
 #include "src/interfaces/rtc_audio_source.h"
+#include "src/interfaces/rtc_certificate.h"
 #include "src/interfaces/rtc_data_channel.h"
 #include "src/interfaces/rtc_dtls_transport.h"
 #include "src/interfaces/rtc_ice_transport.h"
@@ -28,9 +29,13 @@
 #include "src/interfaces/rtc_stats_response.h"
 #include "src/interfaces/rtc_video_sink.h"
 #include "src/interfaces/rtc_video_source.h"
+#include "src/methods/certificate_pool_control.h"
+#include "src/methods/event_loop_control.h"
 #include "src/methods/get_display_media.h"
 #include "src/methods/get_user_media.h"
 #include "src/methods/i420_helpers.h"
+#include "src/methods/resource_usage.h"
+#include "src/methods/tracing.h"
 #include "src/node/async_context_releaser.h"
 #include "src/node/error_factory.h"
 
@@ -38,6 +43,10 @@
 #include "src/test.h"
 #endif
 
+#ifdef NODE_WEBRTC_BENCHMARKS
+#include "src/benchmark.h"
+#endif
+
 static void dispose(void*) {
   node_webrtc::PeerConnectionFactory::Dispose();
 }
@@ -50,6 +59,9 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
     rtc::LogMessage::SetLogToStderr(false);
   #endif 
 
+  // This must come first, so that every TRACE_EVENT sees our tracer.
+  node_webrtc::Tracing::Init(env, exports);
+
   node_webrtc::AsyncContextReleaser::Init(env, exports);
   node_webrtc::ErrorFactory::Init(env, exports);
   node_webrtc::GetDisplayMedia::Init(env, exports);
@@ -61,6 +73,7 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
   node_webrtc::PeerConnectionFactory::Init(env, exports);
   node_webrtc::RTCAudioSink::Init(env, exports);
   node_webrtc::RTCAudioSource::Init(env, exports);
+  node_webrtc::RTCCertificate::Init(env, exports);
   node_webrtc::RTCDataChannel::Init(env, exports);
   node_webrtc::RTCIceTransport::Init(env, exports);
   node_webrtc::RTCDtlsTransport::Init(env, exports);
@@ -72,9 +85,15 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
   node_webrtc::RTCStatsResponse::Init(env, exports);
   node_webrtc::RTCVideoSink::Init(env, exports);
   node_webrtc::RTCVideoSource::Init(env, exports);
+  node_webrtc::ResourceUsage::Init(env, exports);
+  node_webrtc::EventLoopControl::Init(env, exports);
+  node_webrtc::CertificatePoolControl::Init(env, exports);
 #ifdef DEBUG
   node_webrtc::Test::Init(env, exports);
 #endif
+#ifdef NODE_WEBRTC_BENCHMARKS
+  node_webrtc::Benchmark::Init(env, exports);
+#endif
 
   auto status = napi_add_env_cleanup_hook(env, [](void*) {
     dispose(nullptr);
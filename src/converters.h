@@ -107,6 +107,40 @@ struct Converter<S, Either<L, R>> {
   }
 };
 
+/**
+ * A ReferenceConverter converts values from some "source" type S to values of
+ * some "target" type T, just like a Converter. Hot types whose Converter has
+ * been replaced with a hand-written fast path (plain branches, no intermediate
+ * Validation or curry) keep their original implementation here. The fast path
+ * falls back to it whenever validation fails, so error messages stay the same,
+ * and tests use it as the baseline when benchmarking.
+ * @tparam S the source type
+ * @tparam T the target type
+ */
+template <typename S, typename T>
+struct ReferenceConverter {};
+
+/**
+ * This macro declares a node_webrtc::ReferenceConverter from I to O.
+ *
+ * @param I the input type
+ * @param O the output type
+ */
+#define DECLARE_REFERENCE_CONVERTER(I, O) \
+  template <> \
+  struct ReferenceConverter<I, O> { \
+    static Validation<O> Convert(I); \
+  };
+
+/**
+ * This macro simplifies defining a node_webrtc::ReferenceConverter from I to O.
+ *
+ * @param I the input type
+ * @param O the output type
+ * @param V the name of the input variable to convert
+ */
+#define REFERENCE_CONVERTER_IMPL(I, O, V) Validation<O> ReferenceConverter<I, O>::Convert(I V)
+
 template <typename T>
 struct Converter<T*, std::shared_ptr<T>> {
   static Validation<std::shared_ptr<T>> Convert(T* t) {
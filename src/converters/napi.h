@@ -54,6 +54,10 @@ namespace node_webrtc {
 
 #define FROM_NAPI_IMPL(T, V) CONVERTER_IMPL(Napi::Value, T, V)
 
+#define DECLARE_REFERENCE_FROM_NAPI(T) DECLARE_REFERENCE_CONVERTER(Napi::Value, T)
+
+#define REFERENCE_FROM_NAPI_IMPL(T, V) REFERENCE_CONVERTER_IMPL(Napi::Value, T, V)
+
 DECLARE_TO_AND_FROM_NAPI(bool)
 DECLARE_TO_AND_FROM_NAPI(double)
 DECLARE_TO_AND_FROM_NAPI(uint8_t)
@@ -9,25 +9,41 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <limits>
+
 #include <node-addon-api/napi.h>
 
 #include "src/converters.h"
 #include "src/functional/maybe.h"
 #include "src/functional/validation.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
-template <typename T>
-static Validation<T> GetRequired(const Napi::Object object, const std::string& property) {
-  auto maybeValue = object.Get(property);
+static inline Napi::Value GetProperty(const Napi::Object object, const std::string& property) {
+  return object.Get(property);
+}
+
+/**
+ * Property names given as string literals are looked up through
+ * InternedStrings, so they must have static storage duration.
+ */
+static inline Napi::Value GetProperty(const Napi::Object object, const char* property) {
+  return object.Get(InternedStrings::Get(object.Env(), property));
+}
+
+template <typename T, typename K>
+static Validation<T> GetRequired(const Napi::Object object, const K& property) {
+  auto maybeValue = GetProperty(object, property);
   return maybeValue.Env().IsExceptionPending()
       ? Validation<T>::Invalid(maybeValue.Env().GetAndClearPendingException().Message())
       : From<T>(maybeValue);
 }
 
-template <typename T>
-static Validation<Maybe<T>> GetOptional(const Napi::Object object, const std::string& property) {
-  auto maybeValue = object.Get(property);
+template <typename T, typename K>
+static Validation<Maybe<T>> GetOptional(const Napi::Object object, const K& property) {
+  auto maybeValue = GetProperty(object, property);
   if (maybeValue.Env().IsExceptionPending()) {
     return Validation<Maybe<T>>::Invalid(maybeValue.Env().GetAndClearPendingException().Message());
   }
@@ -36,14 +52,54 @@ static Validation<Maybe<T>> GetOptional(const Napi::Object object, const std::st
       : From<T>(maybeValue).Map(&MakeJust<T>);
 }
 
-template <typename T>
+template <typename T, typename K>
 static Validation<T> GetOptional(
     const Napi::Object object,
-    const std::string& property,
+    const K& property,
     T default_value) {
   return GetOptional<T>(object, property).Map([default_value](auto maybeT) {
     return maybeT.FromMaybe(default_value);
   });
 }
 
+/*
+ * TryGetInteger and TryGetArrayBuffer are the branch-only counterparts of
+ * GetRequired and GetOptional, for use by fast-path converters. They never
+ * build a Validation; they only report whether the property could be read.
+ * Callers fall back to their ReferenceConverter to find out why not.
+ */
+
+template <typename T>
+static bool TryGetInteger(const Napi::Object object, const char* property, T* result, bool optional = false) {
+  auto value = GetProperty(object, property);
+  if (value.IsEmpty()) {
+    return false;
+  } else if (optional && value.IsUndefined()) {
+    return true;
+  } else if (!value.IsNumber()) {
+    return false;
+  }
+  auto number = value.As<Napi::Number>();
+  auto doubleValue = number.DoubleValue();
+  if (doubleValue < std::numeric_limits<T>::min() || doubleValue > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  *result = static_cast<T>(number.Int64Value());
+  return true;
+}
+
+static inline bool TryGetArrayBuffer(const Napi::Object object, const char* property, Napi::ArrayBuffer* result) {
+  auto value = GetProperty(object, property);
+  if (value.IsEmpty()) {
+    return false;
+  } else if (value.IsTypedArray()) {
+    *result = value.As<Napi::TypedArray>().ArrayBuffer();
+    return true;
+  } else if (value.IsArrayBuffer()) {
+    *result = value.As<Napi::ArrayBuffer>();
+    return true;
+  }
+  return false;
+}
+
 }  // namespace node_webrtc
@@ -1,6 +1,9 @@
 #include "src/converters/webrtc.h"
 
+#include <webrtc/rtc_base/trace_event.h>
+
 #include "src/functional/validation.h"
+#include "src/node/external_memory.h"
 
 namespace node_webrtc {
 
@@ -11,13 +14,33 @@ TO_NAPI_IMPL(rtc::Buffer*, pair) {
   auto size = buffer->size();
   auto data = new uint8_t[size];
   memcpy(reinterpret_cast<void*>(data), reinterpret_cast<const void*>(buffer->data()), size);
-  auto maybeArrayBuffer = Napi::ArrayBuffer::New(env, data, size, [](Napi::Env, void* data) {
-    delete[] static_cast<uint8_t*>(data);
-  });
+  auto maybeArrayBuffer = ExternalMemory::NewArrayBuffer(env, ExternalMemory::kBuffers, data, size);
   if (maybeArrayBuffer.Env().IsExceptionPending()) {
     return Validation<Napi::Value>::Invalid(maybeArrayBuffer.Env().GetAndClearPendingException().Message());
   }
   return Pure<Napi::Value>(scope.Escape(maybeArrayBuffer));
 }
 
+TO_NAPI_IMPL(webrtc::DataBuffer, pair) {
+  auto env = pair.first;
+  Napi::EscapableHandleScope scope(env);
+  const auto& buffer = pair.second;
+  auto size = buffer.size();
+  TRACE_EVENT2("node_webrtc", "DataBufferToNapi", "size", size, "binary", buffer.binary);
+  if (buffer.binary) {
+    auto data = new uint8_t[size];
+    memcpy(reinterpret_cast<void*>(data), reinterpret_cast<const void*>(buffer.data.data()), size);
+    auto maybeArrayBuffer = ExternalMemory::NewArrayBuffer(env, ExternalMemory::kDataChannelMessages, data, size);
+    if (maybeArrayBuffer.Env().IsExceptionPending()) {
+      return Validation<Napi::Value>::Invalid(maybeArrayBuffer.Env().GetAndClearPendingException().Message());
+    }
+    return Pure<Napi::Value>(scope.Escape(maybeArrayBuffer));
+  }
+  auto maybeString = Napi::String::New(env, reinterpret_cast<const char*>(buffer.data.data()), size);  // NOLINT
+  if (maybeString.Env().IsExceptionPending()) {
+    return Validation<Napi::Value>::Invalid(maybeString.Env().GetAndClearPendingException().Message());
+  }
+  return Pure<Napi::Value>(scope.Escape(maybeString));
+}
+
 }  // namespace node_webrtc
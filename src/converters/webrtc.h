@@ -1,5 +1,6 @@
 #pragma once
 
+#include <webrtc/api/data_channel_interface.h>
 #include <webrtc/rtc_base/buffer.h>
 
 #include "src/converters/napi.h"
@@ -7,5 +8,6 @@
 namespace node_webrtc {
 
 DECLARE_TO_NAPI(rtc::Buffer*)
+DECLARE_TO_NAPI(webrtc::DataBuffer)
 
 }  // namespace node_webrtc
@@ -8,6 +8,7 @@
 #include "src/converters/macros.h"
 #include "src/converters/napi.h"
 #include "src/functional/validation.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
@@ -34,13 +35,25 @@ static Validation<Napi::Object> CreateObject(const Napi::Env env) {
       : Pure(scope.Escape(maybeObject).ToObject());
 }
 
-template <typename T>
-static Maybe<Errors> ConvertAndSet(const Napi::Env env, Napi::Object object, const std::string& key, T value) {
+static inline Napi::Value PropertyKey(const Napi::Env env, const std::string& key) {
+  return Napi::String::New(env, key);
+}
+
+/**
+ * Keys given as string literals are interned per env (see InternedStrings),
+ * so repeated conversions reuse the same V8 string.
+ */
+static inline Napi::Value PropertyKey(const Napi::Env env, const char* key) {
+  return InternedStrings::Get(env, key);
+}
+
+template <typename K, typename T>
+static Maybe<Errors> ConvertAndSet(const Napi::Env env, Napi::Object object, const K& key, T value) {
   auto maybeValue = From<Napi::Value>(std::make_pair(env, value));
   if (maybeValue.IsInvalid()) {
     return MakeJust(maybeValue.ToErrors());
   }
-  object.Set(key, maybeValue.UnsafeFromValid());
+  object.Set(PropertyKey(env, key), maybeValue.UnsafeFromValid());
   if (object.Env().IsExceptionPending()) {
     std::vector<Error> errors = { object.Env().GetAndClearPendingException().Message() };
     return MakeJust(errors);
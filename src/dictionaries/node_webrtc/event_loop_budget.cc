@@ -0,0 +1,24 @@
+#include "src/dictionaries/node_webrtc/event_loop_budget.h"
+
+#include <cmath>
+
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define EVENT_LOOP_BUDGET_FN CreateEventLoopBudget
+
+static Validation<EVENT_LOOP_BUDGET> EVENT_LOOP_BUDGET_FN(
+    const double maxTime,
+    const uint32_t maxEvents) {
+  if (!std::isfinite(maxTime) || maxTime < 0) {
+    return Validation<EVENT_LOOP_BUDGET>::Invalid("Expected maxTime to be a non-negative number of milliseconds");
+  }
+  return Pure<EVENT_LOOP_BUDGET>({maxTime, maxEvents});
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) EVENT_LOOP_BUDGET ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
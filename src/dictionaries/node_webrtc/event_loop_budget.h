@@ -0,0 +1,14 @@
+#pragma once
+
+// IWYU pragma: no_forward_declare node_webrtc::EventLoopBudget
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+#define EVENT_LOOP_BUDGET EventLoopBudget
+#define EVENT_LOOP_BUDGET_LIST \
+  DICT_DEFAULT(double, maxTime, "maxTime", 10) \
+  DICT_DEFAULT(uint32_t, maxEvents, "maxEvents", 0)
+
+#define DICT(X) EVENT_LOOP_BUDGET ## X
+#include "src/dictionaries/macros/def.h"
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
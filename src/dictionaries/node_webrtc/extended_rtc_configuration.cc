@@ -2,6 +2,7 @@
 
 #include "src/converters/object.h"
 #include "src/dictionaries/macros/napi.h"
+#include "src/dictionaries/node_webrtc/rtc_ice_tuning.h"
 #include "src/dictionaries/webrtc/ice_server.h"
 #include "src/dictionaries/webrtc/rtc_configuration.h"
 #include "src/enums/webrtc/bundle_policy.h"
@@ -14,15 +15,19 @@ namespace node_webrtc {
 
 static ExtendedRTCConfiguration CreateExtendedRTCConfiguration(
     const webrtc::PeerConnectionInterface::RTCConfiguration& configuration,
-    const UnsignedShortRange portRange) {
-  return ExtendedRTCConfiguration(configuration, portRange);
+    const UnsignedShortRange portRange,
+    const RTCIceTuning& tuning) {
+  auto tunedConfiguration = configuration;
+  ApplyRTCIceTuning(tuning, &tunedConfiguration);
+  return ExtendedRTCConfiguration(tunedConfiguration, portRange, PortAllocatorFlags(tuning));
 }
 
 FROM_NAPI_IMPL(ExtendedRTCConfiguration, value) {
   return From<Napi::Object>(value).FlatMap<ExtendedRTCConfiguration>([value](auto object) {
     return curry(CreateExtendedRTCConfiguration)
         % From<webrtc::PeerConnectionInterface::RTCConfiguration>(value)
-        * GetOptional<UnsignedShortRange>(object, "portRange", UnsignedShortRange());
+        * GetOptional<UnsignedShortRange>(object, "portRange", UnsignedShortRange())
+        * From<RTCIceTuning>(value);
   });
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include <webrtc/api/peer_connection_interface.h>
 
 #include "src/converters/napi.h"
@@ -10,16 +12,21 @@ namespace node_webrtc {
 struct ExtendedRTCConfiguration {
   ExtendedRTCConfiguration():
     configuration(webrtc::PeerConnectionInterface::RTCConfiguration()),
-    portRange(UnsignedShortRange()) {}
+    portRange(UnsignedShortRange()),
+    portAllocatorFlags(0) {}
 
   ExtendedRTCConfiguration(
       const webrtc::PeerConnectionInterface::RTCConfiguration& configuration,
-      const UnsignedShortRange portRange):
+      const UnsignedShortRange portRange,
+      const uint32_t portAllocatorFlags = 0):
     configuration(configuration),
-    portRange(portRange) {}
+    portRange(portRange),
+    portAllocatorFlags(portAllocatorFlags) {}
 
   webrtc::PeerConnectionInterface::RTCConfiguration configuration;
   UnsignedShortRange portRange;
+  // Added to the cricket::PortAllocator's flags; see RTCIceTuning.
+  uint32_t portAllocatorFlags;
 };
 
 DECLARE_TO_AND_FROM_NAPI(ExtendedRTCConfiguration)
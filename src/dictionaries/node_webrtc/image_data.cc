@@ -11,8 +11,22 @@
 
 namespace node_webrtc {
 
-DECLARE_FROM_NAPI(ImageData)
 FROM_NAPI_IMPL(ImageData, value) {
+  if (value.IsObject()) {
+    auto object = value.As<Napi::Object>();
+    int width;
+    int height;
+    Napi::ArrayBuffer data;
+    if (TryGetInteger(object, "width", &width)
+        && TryGetInteger(object, "height", &height)
+        && TryGetArrayBuffer(object, "data", &data)) {
+      return Pure(ImageData::Create(width, height, data));
+    }
+  }
+  return ReferenceConverter<Napi::Value, ImageData>::Convert(value);
+}
+
+REFERENCE_FROM_NAPI_IMPL(ImageData, value) {
   return From<Napi::Object>(value).FlatMap<ImageData>([](auto object) {
     return curry(ImageData::Create)
         % GetRequired<int>(object, "width")
@@ -105,6 +105,8 @@ class RgbaImageData {
   ImageData data;
 };
 
+DECLARE_FROM_NAPI(ImageData)
+DECLARE_REFERENCE_FROM_NAPI(ImageData)
 DECLARE_FROM_NAPI(I420ImageData)
 DECLARE_FROM_NAPI(RgbaImageData)
 
@@ -0,0 +1,35 @@
+#include "src/dictionaries/node_webrtc/network_conditions.h"
+
+#include <cmath>
+
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define NETWORK_CONDITIONS_FN CreateNetworkConditions
+
+static Validation<NETWORK_CONDITIONS> NETWORK_CONDITIONS_FN(
+    const double delay,
+    const double jitter,
+    const double loss,
+    const double bandwidth,
+    const uint32_t queueLength) {
+  for (auto milliseconds : {delay, jitter}) {
+    if (!std::isfinite(milliseconds) || milliseconds < 0) {
+      return Validation<NETWORK_CONDITIONS>::Invalid("Expected delay and jitter to be non-negative numbers of milliseconds");
+    }
+  }
+  if (!(loss >= 0 && loss <= 1)) {
+    return Validation<NETWORK_CONDITIONS>::Invalid("Expected loss to be a fraction between 0 and 1");
+  }
+  if (!std::isfinite(bandwidth) || bandwidth < 0) {
+    return Validation<NETWORK_CONDITIONS>::Invalid("Expected bandwidth to be a non-negative number of bits per second");
+  }
+  return Pure<NETWORK_CONDITIONS>({delay, jitter, loss, bandwidth, queueLength});
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) NETWORK_CONDITIONS ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
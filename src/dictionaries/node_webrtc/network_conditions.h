@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+// IWYU pragma: no_forward_declare node_webrtc::NetworkConditions
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+#define NETWORK_CONDITIONS NetworkConditions
+#define NETWORK_CONDITIONS_LIST \
+  DICT_DEFAULT(double, delay, "delay", 0) \
+  DICT_DEFAULT(double, jitter, "jitter", 0) \
+  DICT_DEFAULT(double, loss, "loss", 0) \
+  DICT_DEFAULT(double, bandwidth, "bandwidth", 0) \
+  DICT_DEFAULT(uint32_t, queueLength, "queueLength", 0)
+
+#define DICT(X) NETWORK_CONDITIONS ## X
+#include "src/dictionaries/macros/def.h"
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
@@ -0,0 +1,64 @@
+#include "src/dictionaries/node_webrtc/peer_connection_factory_options.h"
+
+#include "src/dictionaries/webrtc/ice_server.h"
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define PEER_CONNECTION_FACTORY_OPTIONS_FN CreatePeerConnectionFactoryOptions
+
+static Validation<PEER_CONNECTION_FACTORY_OPTIONS> PEER_CONNECTION_FACTORY_OPTIONS_FN(
+    const std::vector<std::string>& networks,
+    const bool cacheNetworks,
+    const uint32_t prebindSockets,
+    const uint32_t iceCandidatePoolSize,
+    const webrtc::PeerConnectionInterface::IceServers& iceCandidatePoolServers,
+    const UnsignedShortRange& iceCandidatePoolPortRange,
+    const bool batchUdp,
+    const uint32_t udpReceiveBufferSize,
+    const uint32_t udpSendBufferSize,
+    const bool inProcessNetwork,
+    const NetworkConditions& networkConditions,
+    const bool dataOnly,
+    const bool playoutOnlyForSinks,
+    const bool audioProcessing,
+    const bool echoCancellation,
+    const bool noiseSuppression,
+    const bool autoGainControl,
+    const bool highpassFilter) {
+  if (prebindSockets > 64) {
+    return Validation<PEER_CONNECTION_FACTORY_OPTIONS>::Invalid("Expected prebindSockets to be at most 64");
+  }
+  if (iceCandidatePoolSize > 64) {
+    return Validation<PEER_CONNECTION_FACTORY_OPTIONS>::Invalid("Expected iceCandidatePoolSize to be at most 64");
+  }
+  if (udpReceiveBufferSize > INT32_MAX || udpSendBufferSize > INT32_MAX) {
+    return Validation<PEER_CONNECTION_FACTORY_OPTIONS>::Invalid("Expected UDP buffer sizes to be at most 2^31 - 1 bytes");
+  }
+  return Pure<PEER_CONNECTION_FACTORY_OPTIONS>({
+    networks,
+    cacheNetworks,
+    prebindSockets,
+    iceCandidatePoolSize,
+    iceCandidatePoolServers,
+    iceCandidatePoolPortRange,
+    batchUdp,
+    udpReceiveBufferSize,
+    udpSendBufferSize,
+    inProcessNetwork,
+    networkConditions,
+    dataOnly,
+    playoutOnlyForSinks,
+    audioProcessing,
+    echoCancellation,
+    noiseSuppression,
+    autoGainControl,
+    highpassFilter
+  });
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) PEER_CONNECTION_FACTORY_OPTIONS ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <webrtc/api/peer_connection_interface.h>
+
+#include "src/dictionaries/node_webrtc/network_conditions.h"
+#include "src/dictionaries/node_webrtc/unsigned_short_range.h"
+
+// IWYU pragma: no_forward_declare node_webrtc::PeerConnectionFactoryOptions
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+#define PEER_CONNECTION_FACTORY_OPTIONS PeerConnectionFactoryOptions
+#define PEER_CONNECTION_FACTORY_OPTIONS_LIST \
+  DICT_DEFAULT(std::vector<std::string>, networks, "networks", std::vector<std::string>()) \
+  DICT_DEFAULT(bool, cacheNetworks, "cacheNetworks", false) \
+  DICT_DEFAULT(uint32_t, prebindSockets, "prebindSockets", 0) \
+  DICT_DEFAULT(uint32_t, iceCandidatePoolSize, "iceCandidatePoolSize", 0) \
+  DICT_DEFAULT(webrtc::PeerConnectionInterface::IceServers, iceCandidatePoolServers, "iceCandidatePoolServers", webrtc::PeerConnectionInterface::IceServers()) \
+  DICT_DEFAULT(UnsignedShortRange, iceCandidatePoolPortRange, "iceCandidatePoolPortRange", UnsignedShortRange()) \
+  DICT_DEFAULT(bool, batchUdp, "batchUdp", false) \
+  DICT_DEFAULT(uint32_t, udpReceiveBufferSize, "udpReceiveBufferSize", 0) \
+  DICT_DEFAULT(uint32_t, udpSendBufferSize, "udpSendBufferSize", 0) \
+  DICT_DEFAULT(bool, inProcessNetwork, "inProcessNetwork", false) \
+  DICT_DEFAULT(NetworkConditions, networkConditions, "networkConditions", NetworkConditions()) \
+  DICT_DEFAULT(bool, dataOnly, "dataOnly", false) \
+  DICT_DEFAULT(bool, playoutOnlyForSinks, "playoutOnlyForSinks", false) \
+  DICT_DEFAULT(bool, audioProcessing, "audioProcessing", true) \
+  DICT_DEFAULT(bool, echoCancellation, "echoCancellation", true) \
+  DICT_DEFAULT(bool, noiseSuppression, "noiseSuppression", true) \
+  DICT_DEFAULT(bool, autoGainControl, "autoGainControl", true) \
+  DICT_DEFAULT(bool, highpassFilter, "highpassFilter", true)
+
+#define DICT(X) PEER_CONNECTION_FACTORY_OPTIONS ## X
+#include "src/dictionaries/macros/def.h"
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
@@ -0,0 +1,89 @@
+#include "src/dictionaries/node_webrtc/rtc_certificate_keygen_algorithm.h"
+
+#include <cmath>
+#include <string>
+
+#include "src/converters.h"
+#include "src/converters/object.h"
+#include "src/functional/curry.h"
+#include "src/functional/maybe.h"
+#include "src/functional/operators.h"
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+static const uint32_t kDefaultModulusLength = 2048;
+
+static Validation<int> ToPublicExponent(const Maybe<Napi::ArrayBuffer>& maybePublicExponent) {
+  if (maybePublicExponent.IsNothing()) {
+    return Pure(static_cast<int>(rtc::kRsaDefaultExponent));
+  }
+  // The publicExponent is a big-endian BigInteger, usually [1, 0, 1].
+  auto buffer = maybePublicExponent.UnsafeFromJust();
+  auto data = static_cast<const uint8_t*>(buffer.Data());
+  int64_t exponent = 0;
+  for (size_t i = 0; i < buffer.ByteLength(); i++) {
+    exponent = (exponent << 8) | data[i];
+    if (exponent > INT32_MAX) {
+      return Validation<int>::Invalid("Expected publicExponent to fit in 32 bits");
+    }
+  }
+  return Pure(static_cast<int>(exponent));
+}
+
+static Validation<RTCCertificateKeygenAlgorithm> CreateRTCCertificateKeygenAlgorithm(
+    const std::string& name,
+    const Maybe<std::string>& namedCurve,
+    const uint32_t modulusLength,
+    const Maybe<Napi::ArrayBuffer>& publicExponent,
+    const Maybe<double>& expires) {
+  absl::optional<uint64_t> expiresMs;
+  if (expires.IsJust()) {
+    auto value = expires.UnsafeFromJust();
+    if (!std::isfinite(value) || value < 0) {
+      return Validation<RTCCertificateKeygenAlgorithm>::Invalid("Expected expires to be a non-negative number of milliseconds");
+    }
+    expiresMs = static_cast<uint64_t>(value);
+  }
+
+  if (name == "ECDSA") {
+    if (namedCurve.FromMaybe("P-256") != "P-256") {
+      return Validation<RTCCertificateKeygenAlgorithm>::Invalid("Only the P-256 namedCurve is supported");
+    }
+    return Pure(RTCCertificateKeygenAlgorithm(rtc::KeyParams::ECDSA(rtc::EC_NIST_P256), expiresMs));
+  } else if (name == "RSASSA-PKCS1-v1_5") {
+    auto maybeExponent = ToPublicExponent(publicExponent);
+    if (maybeExponent.IsInvalid()) {
+      return Validation<RTCCertificateKeygenAlgorithm>::Invalid(maybeExponent.ToErrors());
+    }
+    auto params = rtc::KeyParams::RSA(static_cast<int>(modulusLength), maybeExponent.UnsafeFromValid());
+    if (!params.IsValid()) {
+      return Validation<RTCCertificateKeygenAlgorithm>::Invalid("Unsupported modulusLength or publicExponent");
+    }
+    return Pure(RTCCertificateKeygenAlgorithm(params, expiresMs));
+  }
+  return Validation<RTCCertificateKeygenAlgorithm>::Invalid("Expected name to be \"ECDSA\" or \"RSASSA-PKCS1-v1_5\"");
+}
+
+FROM_NAPI_IMPL(RTCCertificateKeygenAlgorithm, value) {
+  if (value.IsString()) {
+    return From<std::string>(value).FlatMap<RTCCertificateKeygenAlgorithm>([](auto name) {
+      return CreateRTCCertificateKeygenAlgorithm(
+              name,
+              MakeNothing<std::string>(),
+              kDefaultModulusLength,
+              MakeNothing<Napi::ArrayBuffer>(),
+              MakeNothing<double>());
+    });
+  }
+  return From<Napi::Object>(value).FlatMap<RTCCertificateKeygenAlgorithm>([](auto object) {
+    return Validation<RTCCertificateKeygenAlgorithm>::Join(curry(CreateRTCCertificateKeygenAlgorithm)
+            % GetRequired<std::string>(object, "name")
+            * GetOptional<std::string>(object, "namedCurve")
+            * GetOptional<uint32_t>(object, "modulusLength", kDefaultModulusLength)
+            * GetOptional<Napi::ArrayBuffer>(object, "publicExponent")
+            * GetOptional<double>(object, "expires"));
+  });
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+#include <absl/types/optional.h>
+#include <webrtc/rtc_base/ssl_identity.h>
+
+#include "src/converters/napi.h"
+
+namespace node_webrtc {
+
+/**
+ * The AlgorithmIdentifier passed to RTCPeerConnection.generateCertificate:
+ * either "ECDSA" or "RSASSA-PKCS1-v1_5", or a dictionary with a name and the
+ * algorithm's parameters, plus an optional `expires` in milliseconds.
+ */
+struct RTCCertificateKeygenAlgorithm {
+  RTCCertificateKeygenAlgorithm(const rtc::KeyParams params, const absl::optional<uint64_t> expires)
+    : params(params)
+    , expires(expires) {}
+  const rtc::KeyParams params;
+  const absl::optional<uint64_t> expires;
+};
+
+DECLARE_FROM_NAPI(RTCCertificateKeygenAlgorithm)
+
+}  // namespace node_webrtc
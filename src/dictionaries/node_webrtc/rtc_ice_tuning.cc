@@ -0,0 +1,87 @@
+#include "src/dictionaries/node_webrtc/rtc_ice_tuning.h"
+
+#include <webrtc/p2p/base/port_allocator.h>
+
+#include "src/functional/maybe.h"
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define RTC_ICE_TUNING_FN CreateRTCIceTuning
+
+static Validation<RTC_ICE_TUNING> RTC_ICE_TUNING_FN(
+    const Maybe<bool>& tcpCandidates,
+    const Maybe<bool>& ipv6,
+    const Maybe<bool>& linkLocalNetworks,
+    const Maybe<bool>& adapterEnumeration,
+    const Maybe<uint32_t>& iceCheckIntervalStrongConnectivity,
+    const Maybe<uint32_t>& iceCheckMinInterval,
+    const Maybe<uint32_t>& iceUnwritableTimeout,
+    const Maybe<uint32_t>& stunCandidateKeepaliveInterval,
+    const Maybe<bool>& iceRenomination,
+    const Maybe<bool>& surfaceIceCandidatesOnIceTransportTypeChanged) {
+  for (auto interval : {iceCheckIntervalStrongConnectivity, iceCheckMinInterval, iceUnwritableTimeout, stunCandidateKeepaliveInterval}) {
+    if (interval.IsJust() && (interval.UnsafeFromJust() == 0 || interval.UnsafeFromJust() > INT32_MAX)) {
+      return Validation<RTC_ICE_TUNING>::Invalid("Expected ICE intervals and timeouts to be positive numbers of milliseconds");
+    }
+  }
+  return Pure<RTC_ICE_TUNING>({
+    tcpCandidates,
+    ipv6,
+    linkLocalNetworks,
+    adapterEnumeration,
+    iceCheckIntervalStrongConnectivity,
+    iceCheckMinInterval,
+    iceUnwritableTimeout,
+    stunCandidateKeepaliveInterval,
+    iceRenomination,
+    surfaceIceCandidatesOnIceTransportTypeChanged
+  });
+}
+
+static absl::optional<int> ToOptionalInt(const Maybe<uint32_t>& maybeInterval, const absl::optional<int>& current) {
+  return maybeInterval.IsJust() ? absl::optional<int>(static_cast<int>(maybeInterval.UnsafeFromJust())) : current;
+}
+
+void ApplyRTCIceTuning(const RTCIceTuning& tuning, webrtc::PeerConnectionInterface::RTCConfiguration* configuration) {
+  if (tuning.tcpCandidates.IsJust()) {
+    configuration->tcp_candidate_policy = tuning.tcpCandidates.UnsafeFromJust()
+        ? webrtc::PeerConnectionInterface::kTcpCandidatePolicyEnabled
+        : webrtc::PeerConnectionInterface::kTcpCandidatePolicyDisabled;
+  }
+  configuration->disable_ipv6 = !tuning.ipv6.FromMaybe(!configuration->disable_ipv6);
+  configuration->disable_link_local_networks = !tuning.linkLocalNetworks.FromMaybe(!configuration->disable_link_local_networks);
+  configuration->ice_check_interval_strong_connectivity = ToOptionalInt(
+          tuning.iceCheckIntervalStrongConnectivity, configuration->ice_check_interval_strong_connectivity);
+  configuration->ice_check_min_interval = ToOptionalInt(tuning.iceCheckMinInterval, configuration->ice_check_min_interval);
+  configuration->ice_unwritable_timeout = ToOptionalInt(tuning.iceUnwritableTimeout, configuration->ice_unwritable_timeout);
+  configuration->stun_candidate_keepalive_interval = ToOptionalInt(
+          tuning.stunCandidateKeepaliveInterval, configuration->stun_candidate_keepalive_interval);
+  configuration->enable_ice_renomination = tuning.iceRenomination.FromMaybe(configuration->enable_ice_renomination);
+  configuration->surface_ice_candidates_on_ice_transport_type_changed = tuning.surfaceIceCandidatesOnIceTransportTypeChanged
+          .FromMaybe(configuration->surface_ice_candidates_on_ice_transport_type_changed);
+}
+
+void CopyRTCIceTuning(
+    const webrtc::PeerConnectionInterface::RTCConfiguration& from,
+    webrtc::PeerConnectionInterface::RTCConfiguration* to) {
+  to->tcp_candidate_policy = from.tcp_candidate_policy;
+  to->disable_ipv6 = from.disable_ipv6;
+  to->disable_link_local_networks = from.disable_link_local_networks;
+  to->ice_check_interval_strong_connectivity = from.ice_check_interval_strong_connectivity;
+  to->ice_check_min_interval = from.ice_check_min_interval;
+  to->ice_unwritable_timeout = from.ice_unwritable_timeout;
+  to->stun_candidate_keepalive_interval = from.stun_candidate_keepalive_interval;
+  to->enable_ice_renomination = from.enable_ice_renomination;
+  to->surface_ice_candidates_on_ice_transport_type_changed = from.surface_ice_candidates_on_ice_transport_type_changed;
+}
+
+uint32_t PortAllocatorFlags(const RTCIceTuning& tuning) {
+  return tuning.adapterEnumeration.FromMaybe(true) ? 0 : cricket::PORTALLOCATOR_DISABLE_ADAPTER_ENUMERATION;
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) RTC_ICE_TUNING ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
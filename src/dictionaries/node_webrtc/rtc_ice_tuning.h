@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+#include <webrtc/api/peer_connection_interface.h>
+
+// IWYU pragma: no_forward_declare node_webrtc::RTCIceTuning
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+#define RTC_ICE_TUNING RTCIceTuning
+#define RTC_ICE_TUNING_LIST \
+  DICT_OPTIONAL(bool, tcpCandidates, "tcpCandidates") \
+  DICT_OPTIONAL(bool, ipv6, "ipv6") \
+  DICT_OPTIONAL(bool, linkLocalNetworks, "linkLocalNetworks") \
+  DICT_OPTIONAL(bool, adapterEnumeration, "adapterEnumeration") \
+  DICT_OPTIONAL(uint32_t, iceCheckIntervalStrongConnectivity, "iceCheckIntervalStrongConnectivity") \
+  DICT_OPTIONAL(uint32_t, iceCheckMinInterval, "iceCheckMinInterval") \
+  DICT_OPTIONAL(uint32_t, iceUnwritableTimeout, "iceUnwritableTimeout") \
+  DICT_OPTIONAL(uint32_t, stunCandidateKeepaliveInterval, "stunCandidateKeepaliveInterval") \
+  DICT_OPTIONAL(bool, iceRenomination, "iceRenomination") \
+  DICT_OPTIONAL(bool, surfaceIceCandidatesOnIceTransportTypeChanged, "surfaceIceCandidatesOnIceTransportTypeChanged")
+
+#define DICT(X) RTC_ICE_TUNING ## X
+#include "src/dictionaries/macros/def.h"
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
+
+namespace node_webrtc {
+
+/**
+ * Set the RTCConfiguration members that an RTCIceTuning sets, leaving the
+ * rest alone. adapterEnumeration is not an RTCConfiguration member; see
+ * PortAllocatorFlags.
+ */
+void ApplyRTCIceTuning(const RTCIceTuning&, webrtc::PeerConnectionInterface::RTCConfiguration*);
+
+/**
+ * Copy the RTCConfiguration members that an RTCIceTuning can set.
+ */
+void CopyRTCIceTuning(
+    const webrtc::PeerConnectionInterface::RTCConfiguration& from,
+    webrtc::PeerConnectionInterface::RTCConfiguration* to);
+
+/**
+ * The cricket::PortAllocator flags to add for an RTCIceTuning.
+ */
+uint32_t PortAllocatorFlags(const RTCIceTuning&);
+
+}  // namespace node_webrtc
@@ -7,6 +7,7 @@
 #include "src/functional/curry.h"
 #include "src/functional/operators.h"
 #include "src/functional/validation.h"
+#include "src/node/external_memory.h"
 
 namespace node_webrtc {
 
@@ -56,6 +57,26 @@ static Validation<RTC_ON_DATA_EVENT_DICT> CreateRTCOnDataEventDict(
 }
 
 FROM_NAPI_IMPL(RTC_ON_DATA_EVENT_DICT, value) {
+  if (value.IsObject()) {
+    auto object = value.As<Napi::Object>();
+    Napi::ArrayBuffer samples;
+    uint8_t bitsPerSample = 16;
+    uint16_t sampleRate = 0;
+    uint8_t channelCount = 1;
+    if (TryGetArrayBuffer(object, "samples", &samples)
+        && TryGetInteger(object, "bitsPerSample", &bitsPerSample, true)
+        && TryGetInteger(object, "sampleRate", &sampleRate)
+        && TryGetInteger(object, "channelCount", &channelCount, true)) {
+      uint16_t numberOfFrames = sampleRate / 100;
+      if (TryGetInteger(object, "numberOfFrames", &numberOfFrames, true)) {
+        return CreateRTCOnDataEventDict(samples, bitsPerSample, sampleRate, channelCount, MakeJust(numberOfFrames));
+      }
+    }
+  }
+  return ReferenceConverter<Napi::Value, RTC_ON_DATA_EVENT_DICT>::Convert(value);
+}
+
+REFERENCE_FROM_NAPI_IMPL(RTC_ON_DATA_EVENT_DICT, value) {
   return From<Napi::Object>(value).FlatMap<RTC_ON_DATA_EVENT_DICT>([](auto object) {
     return Validation<RTC_ON_DATA_EVENT_DICT>::Join(curry(CreateRTCOnDataEventDict)
             % GetRequired<Napi::ArrayBuffer>(object, "samples")
@@ -71,7 +92,7 @@ TO_NAPI_IMPL(RTC_ON_DATA_EVENT_DICT, pair) {
   Napi::EscapableHandleScope scope(env);
 
   auto dict = pair.second;
-  std::unique_ptr<uint8_t> samples(dict.samples);
+  std::unique_ptr<uint8_t[]> samples(dict.samples);
 
   if (dict.numberOfFrames.IsNothing()) {
     return Validation<Napi::Value>::Invalid("numberOfFrames not provided");
@@ -80,9 +101,7 @@ TO_NAPI_IMPL(RTC_ON_DATA_EVENT_DICT, pair) {
 
   auto length = dict.channelCount * numberOfFrames;
   auto byteLength = length * dict.bitsPerSample / 8;
-  auto maybeArrayBuffer = Napi::ArrayBuffer::New(env, samples.release(), byteLength, [](Napi::Env, void* samples) {
-    delete static_cast<uint8_t*>(samples);
-  });
+  auto maybeArrayBuffer = ExternalMemory::NewArrayBuffer(env, ExternalMemory::kAudioData, samples.release(), byteLength);
   if (maybeArrayBuffer.Env().IsExceptionPending()) {
     return Validation<Napi::Value>::Invalid(maybeArrayBuffer.Env().GetAndClearPendingException().Message());
   }
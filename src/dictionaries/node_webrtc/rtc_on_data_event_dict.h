@@ -16,3 +16,9 @@
 #include "src/dictionaries/macros/def.h"
 #include "src/dictionaries/macros/decls.h"
 #undef DICT
+
+namespace node_webrtc {
+
+DECLARE_REFERENCE_FROM_NAPI(RTC_ON_DATA_EVENT_DICT)
+
+}  // namespace node_webrtc
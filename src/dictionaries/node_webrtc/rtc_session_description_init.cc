@@ -5,6 +5,7 @@
 #include <node-addon-api/napi.h>
 #include <webrtc/api/jsep.h>
 
+#include "src/converters/object.h"
 #include "src/dictionaries/macros/napi.h"
 #include "src/functional/curry.h"
 #include "src/functional/operators.h"
@@ -20,6 +21,31 @@ static Validation<RTC_SESSION_DESCRIPTION_INIT> RTC_SESSION_DESCRIPTION_INIT_FN(
   return Pure(CreateRTCSessionDescriptionInit(type, sdp));
 }
 
+FROM_NAPI_IMPL(RTCSessionDescriptionInit, value) {
+  if (value.IsObject()) {
+    auto object = value.As<Napi::Object>();
+    auto type = GetProperty(object, "type");
+    auto sdp = GetProperty(object, "sdp");
+    if (!type.IsEmpty() && type.IsString() && !sdp.IsEmpty() && (sdp.IsUndefined() || sdp.IsString())) {
+      auto maybeType = From<RTCSdpType>(type.As<Napi::String>().Utf8Value());
+      if (maybeType.IsValid()) {
+        return Pure(CreateRTCSessionDescriptionInit(
+                    maybeType.UnsafeFromValid(),
+                    sdp.IsUndefined() ? "" : sdp.As<Napi::String>().Utf8Value()));
+      }
+    }
+  }
+  return ReferenceConverter<Napi::Value, RTCSessionDescriptionInit>::Convert(value);
+}
+
+REFERENCE_FROM_NAPI_IMPL(RTCSessionDescriptionInit, value) {
+  return From<Napi::Object>(value).FlatMap<RTCSessionDescriptionInit>([](auto object) {
+    return Validation<RTCSessionDescriptionInit>::Join(Pure(curry(RTC_SESSION_DESCRIPTION_INIT_FN))
+            * GetRequired<RTCSdpType>(object, "type")
+            * GetOptional<std::string>(object, "sdp", ""));
+  });
+}
+
 TO_NAPI_IMPL(RTCSessionDescriptionInit, pair) {
   auto env = pair.first;
   Napi::EscapableHandleScope scope(env);
@@ -78,7 +104,3 @@ TO_NAPI_IMPL(const webrtc::SessionDescriptionInterface*, pair) {
 }
 
 }  // namespace node_webrtc
-
-#define DICT(X) RTC_SESSION_DESCRIPTION_INIT ## X
-#include "src/dictionaries/macros/impls.h"
-#undef DICT
@@ -9,7 +9,6 @@
 namespace webrtc { class SessionDescriptionInterface; }
 
 // IWYU pragma: no_forward_declare node_webrtc::RTCSessionDescriptionInit
-// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
 
 #define RTC_SESSION_DESCRIPTION_INIT RTCSessionDescriptionInit
 #define RTC_SESSION_DESCRIPTION_INIT_LIST \
@@ -29,6 +28,8 @@ static inline RTC_SESSION_DESCRIPTION_INIT CreateRTCSessionDescriptionInit(
   return {type, sdp};
 }
 
+DECLARE_REFERENCE_FROM_NAPI(RTCSessionDescriptionInit)
+
 DECLARE_CONVERTER(RTCSessionDescriptionInit, webrtc::SessionDescriptionInterface*)
 DECLARE_CONVERTER(const webrtc::SessionDescriptionInterface*, RTCSessionDescriptionInit)
 
@@ -0,0 +1,18 @@
+#include "src/dictionaries/node_webrtc/rtc_video_sink_init.h"
+
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define RTC_VIDEO_SINK_INIT_FN CreateRTCVideoSinkInit
+
+static Validation<RTC_VIDEO_SINK_INIT> RTC_VIDEO_SINK_INIT_FN(
+    const bool coalesceFrames) {
+  return Pure<RTC_VIDEO_SINK_INIT>({coalesceFrames});
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) RTC_VIDEO_SINK_INIT ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
@@ -0,0 +1,13 @@
+#pragma once
+
+// IWYU pragma: no_forward_declare node_webrtc::RTCVideoSinkInit
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+#define RTC_VIDEO_SINK_INIT RTCVideoSinkInit
+#define RTC_VIDEO_SINK_INIT_LIST \
+  DICT_DEFAULT(bool, coalesceFrames, "coalesceFrames", false)
+
+#define DICT(X) RTC_VIDEO_SINK_INIT ## X
+#include "src/dictionaries/macros/def.h"
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
@@ -14,6 +14,7 @@
 #include "src/enums/node_webrtc/rtc_ice_component.h"
 #include "src/functional/maybe.h"  // IWYU pragma: keep
 #include "src/functional/validation.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
@@ -80,14 +81,14 @@ TO_NAPI_IMPL(webrtc::IceCandidateInterface*, pair) {
 
   const auto& mid = value->sdp_mid();
   if (mid.empty()) {
-    object.Set("sdpMid", env.Null());
+    object.Set(InternedStrings::Get(env, "sdpMid"), env.Null());
   } else {
     NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "sdpMid", mid)
   }
 
   auto mLineIndex = value->sdp_mline_index();
   if (mLineIndex < 0) {
-    object.Set("sdpMLineIndex", env.Null());
+    object.Set(InternedStrings::Get(env, "sdpMLineIndex"), env.Null());
   } else {
     NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "sdpMLineIndex", mLineIndex)
   }
@@ -102,14 +103,14 @@ TO_NAPI_IMPL(webrtc::IceCandidateInterface*, pair) {
 
   const auto& tcpType = candidate.tcptype();
   if (tcpType.empty()) {
-    object.Set("tcpType", env.Null());
+    object.Set(InternedStrings::Get(env, "tcpType"), env.Null());
   } else {
     NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "tcpType", candidate.tcptype())
   }
 
   if (type == RTCIceCandidateType::kHost) {
-    object.Set("relatedAddress", env.Null());
-    object.Set("relatedPort", env.Null());
+    object.Set(InternedStrings::Get(env, "relatedAddress"), env.Null());
+    object.Set(InternedStrings::Get(env, "relatedPort"), env.Null());
   } else {
     NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "relatedAddress", candidate.related_address().hostname())
     NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "relatedPort", candidate.related_address().port())
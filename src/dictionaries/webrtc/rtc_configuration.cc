@@ -25,7 +25,7 @@ FROM_NAPI_IMPL(webrtc::PeerConnectionInterface::RTCConfiguration, value) {
         * GetOptional<webrtc::PeerConnectionInterface::BundlePolicy>(object, "bundlePolicy", webrtc::PeerConnectionInterface::BundlePolicy::kBundlePolicyBalanced)
         * GetOptional<webrtc::PeerConnectionInterface::RtcpMuxPolicy>(object, "rtcpMuxPolicy", webrtc::PeerConnectionInterface::RtcpMuxPolicy::kRtcpMuxPolicyRequire)
         * GetOptional<std::string>(object, "peerIdentity")
-        * GetOptional<std::vector<Napi::Object>>(object, "certificates")
+        * GetOptional<std::vector<RTCCertificate*>>(object, "certificates")
         // TODO(mroberts): Implement EnforceRange and change to uint8_t.
         * GetOptional<uint8_t>(object, "iceCandidatePoolSize", 0)
         * GetOptional<webrtc::SdpSemantics>(object, "sdpSemantics", sdp_semantics);
@@ -4,6 +4,7 @@
 
 #include "src/converters/napi.h"
 #include "src/functional/maybe.h"
+#include "src/interfaces/rtc_certificate.h"
 
 namespace node_webrtc {
 
@@ -13,7 +14,7 @@ static inline webrtc::PeerConnectionInterface::RTCConfiguration CreateRTCConfigu
     const webrtc::PeerConnectionInterface::BundlePolicy bundlePolicy,
     const webrtc::PeerConnectionInterface::RtcpMuxPolicy rtcpMuxPolicy,
     const Maybe<std::string>&,
-    const Maybe<std::vector<Napi::Object>>&,
+    const Maybe<std::vector<RTCCertificate*>>& certificates,
     const uint32_t iceCandidatePoolSize,
     const webrtc::SdpSemantics sdpSemantics) {
   webrtc::PeerConnectionInterface::RTCConfiguration configuration;
@@ -21,6 +22,9 @@ static inline webrtc::PeerConnectionInterface::RTCConfiguration CreateRTCConfigu
   configuration.type = iceTransportsPolicy;
   configuration.bundle_policy = bundlePolicy;
   configuration.rtcp_mux_policy = rtcpMuxPolicy;
+  for (auto certificate : certificates.FromMaybe(std::vector<RTCCertificate*>())) {
+    configuration.certificates.push_back(certificate->certificate());
+  }
   configuration.ice_candidate_pool_size = iceCandidatePoolSize;
   configuration.sdp_semantics = sdpSemantics;
   return configuration;
@@ -1,5 +1,6 @@
 #include "src/dictionaries/webrtc/rtc_stats.h"
 
+#include <cstring>
 #include <iosfwd>
 #include <string>
 #include <utility>
@@ -11,6 +12,7 @@
 #include "src/dictionaries/macros/napi.h"
 #include "src/dictionaries/webrtc/rtc_stats_member_interface.h"  // IWYU pragma: keep
 #include "src/functional/validation.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 	TO_NAPI_IMPL(const webrtc::RTCStats*, pair) {
@@ -20,11 +22,11 @@ namespace node_webrtc {
 		NODE_WEBRTC_CREATE_OBJECT_OR_RETURN(env, stats)
 		NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, stats, "id", value->id())
 		NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, stats, "timestamp", value->timestamp_us() / 1000.0)
-		NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, stats, "type", std::string(value->type()))
+		NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, stats, "type", Napi::Value(InternedStrings::Get(env, value->type())))
 
 		for (const webrtc::RTCStatsMemberInterface* member : value->Members()) {
 			// TODO(liam): qualityLimitationDurations can't be parsed through this labrynth
-			if (member->name() == "qualityLimitationDurations")
+			if (std::strcmp(member->name(), "qualityLimitationDurations") == 0)
 				continue;
 
 			if (member->is_defined()) {
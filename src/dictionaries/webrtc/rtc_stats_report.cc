@@ -3,6 +3,7 @@
 #include <node-addon-api/napi.h>
 #include <webrtc/api/scoped_refptr.h>  // IWYU pragma: keep
 #include <webrtc/api/stats/rtc_stats_report.h>  // IWYU pragma: keep
+#include <webrtc/rtc_base/trace_event.h>
 
 #include "src/converters/object.h"
 #include "src/dictionaries/webrtc/rtc_stats.h"  // IWYU pragma: keep
@@ -55,6 +56,7 @@ static Maybe<Errors> DoSet(Napi::Object map, std::string key, T value) {
 }
 
 TO_NAPI_IMPL(rtc::scoped_refptr<webrtc::RTCStatsReport>, pair) {
+  TRACE_EVENT0("node_webrtc", "RTCStatsReportToNapi");
   return CreateMap(pair.first).FlatMap<Napi::Value>([value = pair.second](auto map) {
     auto env = map.Env();
     Napi::EscapableHandleScope scope(env);
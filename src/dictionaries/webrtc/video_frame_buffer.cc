@@ -1,14 +1,17 @@
 #include "src/dictionaries/webrtc/video_frame_buffer.h"
 
 #include <webrtc/api/video/i420_buffer.h>
+#include <webrtc/rtc_base/trace_event.h>
 
 #include "src/dictionaries/node_webrtc/image_data.h"
 #include "src/functional/validation.h"
+#include "src/node/external_memory.h"
 
 namespace node_webrtc {
 
 static rtc::scoped_refptr<webrtc::I420Buffer> CreateI420Buffer(
     I420ImageData i420Frame) {
+  TRACE_EVENT2("node_webrtc", "CreateI420Buffer", "width", i420Frame.width(), "height", i420Frame.height());
   auto buffer = webrtc::I420Buffer::Create(i420Frame.width(), i420Frame.height());
   memcpy(buffer->MutableDataY(), i420Frame.dataY(), i420Frame.sizeOfLuminancePlane());
   memcpy(buffer->MutableDataU(), i420Frame.dataU(), i420Frame.sizeOfChromaPlane());
@@ -33,6 +36,7 @@ TO_NAPI_IMPL(const webrtc::I420BufferInterface*, pair) {
   auto env = pair.first;
   Napi::EscapableHandleScope scope(env);
   auto value = pair.second;
+  TRACE_EVENT2("node_webrtc", "I420BufferToNapi", "width", value->width(), "height", value->height());
 
   auto sizeOfSrcYPlane = value->StrideY() * value->height();
   auto sizeOfSrcUPlane = value->StrideU() * value->height() / 2;
@@ -41,12 +45,10 @@ TO_NAPI_IMPL(const webrtc::I420BufferInterface*, pair) {
   auto sizeOfDstUPlane = sizeOfDstYPlane / 4;
   auto sizeOfDstVPlane = sizeOfDstYPlane / 4;
 
+  // Unlike Napi::ArrayBuffer::New(env, byteLength), this skips zero-filling
+  // memory we are about to overwrite.
   auto byteLength = sizeOfDstYPlane + sizeOfDstUPlane + sizeOfDstVPlane;
-  auto maybeArrayBuffer = Napi::ArrayBuffer::New(env, byteLength);
-  if (maybeArrayBuffer.Env().IsExceptionPending()) {
-    return Validation<Napi::Value>::Invalid(maybeArrayBuffer.Env().GetAndClearPendingException().Message());
-  }
-  auto data = static_cast<uint8_t*>(maybeArrayBuffer.Data());
+  auto data = new uint8_t[byteLength];
 
   auto srcYPlane = value->DataY();
   auto srcUPlane = value->DataU();
@@ -78,6 +80,11 @@ TO_NAPI_IMPL(const webrtc::I420BufferInterface*, pair) {
     }
   }
 
+  auto maybeArrayBuffer = ExternalMemory::NewArrayBuffer(env, ExternalMemory::kVideoFrames, data, byteLength);
+  if (maybeArrayBuffer.Env().IsExceptionPending()) {
+    return Validation<Napi::Value>::Invalid(maybeArrayBuffer.Env().GetAndClearPendingException().Message());
+  }
+
   // FIXME(mroberts): How to create a Uint8ClampedArray?
   auto maybeUint8Array = Napi::Uint8Array::New(env, byteLength, maybeArrayBuffer, 0);
   if (maybeUint8Array.Env().IsExceptionPending()) {
@@ -6,6 +6,7 @@
 
 #include "src/converters.h"
 #include "src/converters/napi.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
@@ -43,10 +44,21 @@ CONVERTER_IMPL(std::string, ENUM(), value) {
   return Validation<ENUM()>::Invalid("Invalid " ENUM(_NAME));
 }
 
+#undef ENUM_SUPPORTED
+#undef ENUM_UNSUPPORTED
+
+#define ENUM_SUPPORTED(VALUE, STRING) \
+  case VALUE: \
+  return Pure<Napi::Value>(InternedStrings::Get(pair.first, STRING));
+
+#define ENUM_UNSUPPORTED(VALUE, STRING, ERROR) \
+  case VALUE: \
+  return Validation<Napi::Value>::Invalid(ERROR);
+
 TO_NAPI_IMPL(ENUM(), pair) {
-  return From<std::string>(pair.second).FlatMap<Napi::Value>([env = pair.first](auto value) {
-    return From<Napi::Value>(std::make_pair(env, value));
-  });
+  switch (pair.second) {
+      ENUM(_LIST)
+  }
 }
 
 #undef ENUM_SUPPORTED
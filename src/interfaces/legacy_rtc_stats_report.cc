@@ -25,7 +25,7 @@ Napi::FunctionReference& LegacyStatsReport::constructor() {
   return constructor;
 }
 
-LegacyStatsReport::LegacyStatsReport(const Napi::CallbackInfo& info): Napi::ObjectWrap<LegacyStatsReport>(info) {
+LegacyStatsReport::LegacyStatsReport(const Napi::CallbackInfo& info): Napi::ObjectWrap<LegacyStatsReport>(info), Counted<LegacyStatsReport>("LegacyStatsReport") {
   if (info.Length() != 2 || !info[0].IsExternal() || !info[1].IsExternal()) {
     Napi::TypeError::New(info.Env(), "You cannot construct an LegacyStatsReport").ThrowAsJavaScriptException();
     return;
@@ -15,10 +15,13 @@
 
 #include <node-addon-api/napi.h>
 
+#include "src/node/object_census.h"
+
 namespace node_webrtc {
 
 class LegacyStatsReport
-  : public Napi::ObjectWrap<LegacyStatsReport> {
+  : public Napi::ObjectWrap<LegacyStatsReport>
+  , public Counted<LegacyStatsReport> {
  public:
   explicit LegacyStatsReport(const Napi::CallbackInfo&);
 
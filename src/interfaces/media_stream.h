@@ -15,6 +15,7 @@
 #include <webrtc/api/scoped_refptr.h>
 
 #include "src/converters/napi.h"
+#include "src/node/object_census.h"
 #include "src/node/wrap.h"
 
 namespace webrtc { class MediaStreamInterface; }
@@ -27,7 +28,8 @@ class PeerConnectionFactory;
 struct RTCMediaStreamInit;
 
 class MediaStream
-  : public Napi::ObjectWrap<MediaStream> {
+  : public Napi::ObjectWrap<MediaStream>
+  , public Counted<MediaStream> {
  public:
   MediaStream(const Napi::CallbackInfo&);
 
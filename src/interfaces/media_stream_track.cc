@@ -175,6 +175,7 @@ MediaStreamTrack* MediaStreamTrack::Create(
 
 void MediaStreamTrack::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(env, "MediaStreamTrack", {
+    InstanceMethod("getQueueMetrics", &MediaStreamTrack::GetQueueMetrics),
     InstanceAccessor("enabled", &MediaStreamTrack::GetEnabled, &MediaStreamTrack::SetEnabled),
     InstanceAccessor("id", &MediaStreamTrack::GetId, nullptr),
     InstanceAccessor("kind", &MediaStreamTrack::GetKind, nullptr),
@@ -15,6 +15,8 @@
 #include <type_traits>
 #include <utility>
 
+#include <webrtc/rtc_base/trace_event.h>
+
 #include "src/converters.h"
 #include "src/converters/arguments.h"
 #include "src/converters/napi.h"
@@ -22,7 +24,9 @@
 #include "src/functional/maybe.h"
 #include "src/functional/validation.h"
 #include "src/interfaces/media_stream_track.h"  // IWYU pragma: keep
+#include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
 #include "src/node/events.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
@@ -44,6 +48,12 @@ RTCAudioSink::RTCAudioSink(const Napi::CallbackInfo& info)
 
   _track = std::move(track);
   _track->AddSink(this);
+  // Only sinks on remote tracks need playout; local RTCAudioSource data does not go through it.
+  auto source = _track->GetSource();
+  _remote = source && source->remote();
+  if (_remote) {
+    PeerConnectionFactory::AddAudioSink();
+  }
 }
 
 Napi::Value RTCAudioSink::GetStopped(const Napi::CallbackInfo& info) {
@@ -56,6 +66,9 @@ void RTCAudioSink::Stop() {
     _stopped = true;
     _track->RemoveSink(this);
     _track = nullptr;
+    if (_remote) {
+      PeerConnectionFactory::RemoveAudioSink();
+    }
   }
   AsyncObjectWrapWithLoop<RTCAudioSink>::Stop();
 }
@@ -71,6 +84,7 @@ void RTCAudioSink::OnData(
     int sample_rate,
     size_t number_of_channels,
     size_t number_of_frames) {
+  TRACE_EVENT1("node_webrtc", "RTCAudioSink::OnData", "frames", number_of_frames);
   auto byte_length = number_of_channels * number_of_frames * bits_per_sample / 8;
   std::unique_ptr<uint8_t[]> audio_data_copy(new uint8_t[byte_length]);
   if (!audio_data_copy) {
@@ -105,13 +119,14 @@ void RTCAudioSink::OnData(
       return;
     }
     auto object = maybeValue.UnsafeFromValid().ToObject();
-    object.Set("type", Napi::String::New(env, "data"));
+    object.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "data"));
     MakeCallback("dispatchEvent", { object });
-  }));
+  }), EventLane::kMedia);
 }
 
 void RTCAudioSink::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(env, "RTCAudioSink", {
+    InstanceMethod("getQueueMetrics", &RTCAudioSink::GetQueueMetrics),
     InstanceAccessor("stopped", &RTCAudioSink::GetStopped, nullptr),
     InstanceMethod("stop", &RTCAudioSink::JsStop)
   });
@@ -44,6 +44,7 @@ class RTCAudioSink
 
   Napi::Value JsStop(const Napi::CallbackInfo&);
 
+  bool _remote = false;
   bool _stopped = false;
   rtc::scoped_refptr<webrtc::AudioTrackInterface> _track;
 };
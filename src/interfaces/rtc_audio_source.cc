@@ -25,7 +25,7 @@ Napi::FunctionReference& RTCAudioSource::constructor() {
 }
 
 RTCAudioSource::RTCAudioSource(const Napi::CallbackInfo& info)
-  : Napi::ObjectWrap<RTCAudioSource>(info) {
+  : Napi::ObjectWrap<RTCAudioSource>(info), Counted<RTCAudioSource>("RTCAudioSource") {
   _source = new rtc::RefCountedObject<RTCAudioTrackSource>();
 }
 
@@ -13,6 +13,7 @@
 #include <memory>
 
 #include <node-addon-api/napi.h>
+#include <webrtc/api/audio_options.h>
 #include <webrtc/api/media_stream_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/pc/local_audio_source.h>
@@ -20,12 +21,13 @@
 #include "src/dictionaries/node_webrtc/rtc_on_data_event_dict.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
 #include "src/interfaces/media_stream_track.h"
+#include "src/node/object_census.h"
 
 namespace node_webrtc {
 
 class RTCAudioTrackSource : public webrtc::LocalAudioSource {
  public:
-  RTCAudioTrackSource() {}
+  RTCAudioTrackSource(): _options(_factory->audioOptions()) {}
 
   ~RTCAudioTrackSource() override {
     PeerConnectionFactory::Release();
@@ -40,6 +42,10 @@ class RTCAudioTrackSource : public webrtc::LocalAudioSource {
     return false;
   }
 
+  const cricket::AudioOptions options() const override {
+    return _options;
+  }
+
   void PushData(RTCOnDataEventDict dict) {
     webrtc::AudioTrackSinkInterface* sink = _sink;
     if (sink && dict.numberOfFrames.IsJust()) {
@@ -65,12 +71,14 @@ class RTCAudioTrackSource : public webrtc::LocalAudioSource {
 
  private:
   PeerConnectionFactory* _factory = PeerConnectionFactory::GetOrCreateDefault();
+  const cricket::AudioOptions _options;
 
   std::atomic<webrtc::AudioTrackSinkInterface*> _sink = {nullptr};
 };
 
 class RTCAudioSource
-  : public Napi::ObjectWrap<RTCAudioSource> {
+  : public Napi::ObjectWrap<RTCAudioSource>
+  , public Counted<RTCAudioSource> {
  public:
   RTCAudioSource(const Napi::CallbackInfo&);
   static void Init(Napi::Env, Napi::Object);
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/interfaces/rtc_certificate.h"
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <webrtc/rtc_base/ssl_fingerprint.h>
+
+#include "src/converters.h"
+#include "src/converters/arguments.h"
+#include "src/converters/interfaces.h"
+#include "src/dictionaries/node_webrtc/rtc_certificate_keygen_algorithm.h"
+#include "src/node/error_factory.h"
+#include "src/node/event_dispatcher.h"
+#include "src/node/utility.h"
+#include "src/webrtc/certificate_pool.h"
+
+namespace node_webrtc {
+
+namespace {
+
+/**
+ * A pending generateCertificate call. It keeps the Node loop alive while the
+ * CertificatePool generates the certificate, then settles the promise on the
+ * main thread and deletes itself.
+ */
+class GenerateCertificateRequest: public EventDispatcher::Runnable {
+ public:
+  GenerateCertificateRequest(EventDispatcher* dispatcher, Napi::Promise::Deferred deferred)
+    : _dispatcher(dispatcher)
+    , _deferred(deferred) {
+    _dispatcher->Register(this);
+  }
+
+  void DidGenerate(rtc::scoped_refptr<rtc::RTCCertificate> certificate) {
+    // On the CertificatePool's thread; Schedule orders this write before Run.
+    _certificate = std::move(certificate);
+    _dispatcher->Schedule(this);
+  }
+
+  void Run() override {
+    _dispatcher->Unregister(this);
+    auto env = _deferred.Env();
+    Napi::HandleScope scope(env);
+    if (_certificate) {
+      Resolve(_deferred, RTCCertificate::Create(_certificate));
+    } else {
+      Reject(_deferred, ErrorFactory::CreateOperationError(env, "Failed to generate the certificate"));
+    }
+    delete this;
+  }
+
+ private:
+  EventDispatcher* _dispatcher;
+  Napi::Promise::Deferred _deferred;
+  rtc::scoped_refptr<rtc::RTCCertificate> _certificate;
+};
+
+}  // namespace
+
+Napi::FunctionReference& RTCCertificate::constructor() {
+  static Napi::FunctionReference constructor;
+  return constructor;
+}
+
+RTCCertificate::RTCCertificate(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<RTCCertificate>(info)
+  , Counted<RTCCertificate>("RTCCertificate") {
+  if (info.Length() != 1 || !info[0].IsExternal()) {
+    Napi::TypeError::New(info.Env(), "You cannot construct an RTCCertificate; use RTCPeerConnection.generateCertificate").ThrowAsJavaScriptException();
+    return;
+  }
+  _certificate = *info[0].As<Napi::External<rtc::scoped_refptr<rtc::RTCCertificate>>>().Data();
+}
+
+RTCCertificate* RTCCertificate::Create(rtc::scoped_refptr<rtc::RTCCertificate> certificate) {
+  auto env = constructor().Env();
+  Napi::HandleScope scope(env);
+
+  auto object = constructor().New({
+    Napi::External<rtc::scoped_refptr<rtc::RTCCertificate>>::New(env, &certificate)
+  });
+
+  return Unwrap(object);
+}
+
+Napi::Value RTCCertificate::GenerateCertificate(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  CREATE_DEFERRED(env, deferred)
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, algorithm, RTCCertificateKeygenAlgorithm)
+
+  auto dispatcher = EventDispatcher::For(env);
+  if (!dispatcher) {
+    deferred.Reject(env.GetAndClearPendingException().Value());
+    return deferred.Promise();
+  }
+
+  auto request = new GenerateCertificateRequest(dispatcher, deferred);
+  CertificatePool::Get()->Generate(algorithm.params, algorithm.expires, [request](auto certificate) {
+    request->DidGenerate(std::move(certificate));
+  });
+
+  return deferred.Promise();
+}
+
+Napi::Value RTCCertificate::GetExpires(const Napi::CallbackInfo& info) {
+  // Milliseconds since the epoch, as a DOMTimeStamp.
+  return Napi::Number::New(info.Env(), static_cast<double>(_certificate->Expires()));
+}
+
+Napi::Value RTCCertificate::GetFingerprints(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  auto fingerprints = Napi::Array::New(env);
+  auto fingerprint = rtc::SSLFingerprint::CreateFromCertificate(*_certificate);
+  if (fingerprint) {
+    auto value = fingerprint->GetRfc4572Fingerprint();
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+      return static_cast<char>(std::tolower(c));
+    });
+    auto object = Napi::Object::New(env);
+    object.Set("algorithm", Napi::String::New(env, fingerprint->algorithm));
+    object.Set("value", Napi::String::New(env, value));
+    fingerprints.Set(0u, object);
+  }
+  return fingerprints;
+}
+
+void RTCCertificate::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "RTCCertificate", {
+    InstanceAccessor("expires", &RTCCertificate::GetExpires, nullptr),
+    InstanceMethod("getFingerprints", &RTCCertificate::GetFingerprints)
+  });
+
+  constructor() = Napi::Persistent(func);
+  constructor().SuppressDestruct();
+
+  exports.Set("RTCCertificate", func);
+}
+
+CONVERT_INTERFACE_TO_AND_FROM_NAPI(RTCCertificate, "RTCCertificate")
+
+}  // namespace node_webrtc
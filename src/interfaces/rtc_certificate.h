@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/scoped_refptr.h>
+#include <webrtc/rtc_base/rtc_certificate.h>
+
+#include "src/converters/napi.h"
+#include "src/node/object_census.h"
+
+namespace node_webrtc {
+
+/**
+ * RTCCertificate wraps a certificate created by
+ * RTCPeerConnection.generateCertificate, which can then be passed in an
+ * RTCConfiguration's `certificates`.
+ */
+class RTCCertificate
+  : public Napi::ObjectWrap<RTCCertificate>
+  , public Counted<RTCCertificate> {
+ public:
+  explicit RTCCertificate(const Napi::CallbackInfo&);
+
+  static void Init(Napi::Env, Napi::Object);
+
+  static Napi::FunctionReference& constructor();
+
+  static RTCCertificate* Create(rtc::scoped_refptr<rtc::RTCCertificate>);
+
+  /**
+   * RTCPeerConnection.generateCertificate. Keys are generated on the
+   * CertificatePool's thread.
+   */
+  static Napi::Value GenerateCertificate(const Napi::CallbackInfo&);
+
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate() { return _certificate; }
+
+ private:
+  Napi::Value GetExpires(const Napi::CallbackInfo&);
+  Napi::Value GetFingerprints(const Napi::CallbackInfo&);
+
+  rtc::scoped_refptr<rtc::RTCCertificate> _certificate;
+};
+
+DECLARE_TO_AND_FROM_NAPI(RTCCertificate*)
+
+}  // namespace node_webrtc
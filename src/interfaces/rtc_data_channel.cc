@@ -14,12 +14,15 @@
 #include <webrtc/api/data_channel_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/rtc_base/copy_on_write_buffer.h>
+#include <webrtc/rtc_base/logging.h>
 
+#include "src/converters/webrtc.h"
 #include "src/enums/node_webrtc/binary_type.h"
 #include "src/enums/webrtc/data_state.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
 #include "src/node/error_factory.h"
 #include "src/node/events.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
@@ -137,9 +140,9 @@ void RTCDataChannel::HandleStateChange(RTCDataChannel& channel, webrtc::DataChan
   Napi::HandleScope scope(env);
   auto object = Napi::Object::New(env);
   if (state == webrtc::DataChannelInterface::kClosed) {
-    object.Set("type", Napi::String::New(env, "close"));
+    object.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "close"));
   } else if (state == webrtc::DataChannelInterface::kOpen) {
-    object.Set("type", Napi::String::New(env, "open"));
+    object.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "open"));
   }
   channel.MakeCallback("dispatchEvent", { object });
   if (state == webrtc::DataChannelInterface::kClosed) {
@@ -154,26 +157,22 @@ void RTCDataChannel::OnMessage(const webrtc::DataBuffer& buffer) {
 }
 
 void RTCDataChannel::HandleMessage(RTCDataChannel& channel, const webrtc::DataBuffer& buffer) {
-  bool binary = buffer.binary;
-  size_t size = buffer.size();
-
   auto env = channel.Env();
   Napi::HandleScope scope(env);
-  Napi::Value value;
-  if (binary) {
-    char* message = new char[size];
-    memcpy(reinterpret_cast<void*>(message), reinterpret_cast<const void*>(buffer.data.data()), size);
-    auto array = Napi::ArrayBuffer::New(env, message, size, [](Napi::Env, void* buffer) {
-      delete[] static_cast<char*>(buffer);
-    });
-    value = array;  // NOLINT
-  } else {
-    auto str = Napi::String::New(env, reinterpret_cast<const char*>(buffer.data.data()), size);  // NOLINT
-    value = str;
+  auto maybeValue = From<Napi::Value>(std::make_pair(env, buffer));
+  if (maybeValue.IsInvalid()) {
+    // Do not drop the message silently; tell the application it was lost, and why.
+    auto reason = maybeValue.ToErrors()[0];
+    RTC_LOG(LS_ERROR) << "Dropped an RTCDataChannel message of " << buffer.size() << " bytes: " << reason;
+    auto event = Napi::Object::New(env);
+    event.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "error"));
+    event.Set(InternedStrings::Get(env, "error"), Napi::Error::New(env, "Unable to deliver a message: " + reason).Value());
+    channel.MakeCallback("dispatchEvent", { event });
+    return;
   }
   auto object = Napi::Object::New(env);
-  object.Set("type", "message");
-  object.Set("data", value);
+  object.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "message"));
+  object.Set(InternedStrings::Get(env, "data"), maybeValue.UnsafeFromValid());
   channel.MakeCallback("dispatchEvent", { object });
 }
 
@@ -356,6 +355,7 @@ RTCDataChannel* RTCDataChannel::Create(
 
 void RTCDataChannel::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(env, "RTCDataChannel", {
+    InstanceMethod("getQueueMetrics", &RTCDataChannel::GetQueueMetrics),
     InstanceAccessor("bufferedAmount", &RTCDataChannel::GetBufferedAmount, nullptr),
     InstanceAccessor("id", &RTCDataChannel::GetId, nullptr),
     InstanceAccessor("label", &RTCDataChannel::GetLabel, nullptr),
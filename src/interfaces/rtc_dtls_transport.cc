@@ -28,6 +28,7 @@
 #include "src/interfaces/rtc_ice_transport.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
 #include "src/node/events.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
@@ -109,7 +110,7 @@ void RTCDtlsTransport::OnStateChange(webrtc::DtlsTransportInformation informatio
     auto env = Env();
     Napi::HandleScope scope(env);
     auto event = Napi::Object::New(env);
-    event.Set("type", Napi::String::New(env, "statechange"));
+    event.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "statechange"));
     MakeCallback("dispatchEvent", { event });
   }));
 
@@ -129,8 +130,8 @@ void RTCDtlsTransport::OnError(webrtc::RTCError rtcError) {
       if (maybeValue.IsValid()) {
         auto value = maybeValue.UnsafeFromValid();
         auto event = Napi::Object::New(env);
-        event.Set("type", Napi::String::New(env, "error"));
-        event.Set("error", value);
+        event.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "error"));
+        event.Set(InternedStrings::Get(env, "error"), value);
         MakeCallback("dispatchEvent", { event });
       }
     }));
@@ -190,6 +191,7 @@ RTCDtlsTransport* RTCDtlsTransport::Create(
 
 void RTCDtlsTransport::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(env, "RTCDtlsTransport", {
+    InstanceMethod("getQueueMetrics", &RTCDtlsTransport::GetQueueMetrics),
     InstanceMethod("getRemoteCertificates", &RTCDtlsTransport::GetRemoteCertificates),
     InstanceAccessor("iceTransport", &RTCDtlsTransport::GetIceTransport, nullptr),
     InstanceAccessor("state", &RTCDtlsTransport::GetState, nullptr)
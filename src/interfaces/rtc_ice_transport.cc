@@ -15,6 +15,7 @@
 #include "src/enums/webrtc/ice_role.h"
 #include "src/enums/webrtc/ice_transport_state.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
@@ -123,7 +124,7 @@ void RTCIceTransport::OnStateChanged(cricket::IceTransportInternal*) {
     auto env = Env();
     Napi::HandleScope scope(env);
     auto event = Napi::Object::New(env);
-    event.Set("type", Napi::String::New(env, "statechange"));
+    event.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "statechange"));
     MakeCallback("dispatchEvent", { event });
   }));
 
@@ -139,7 +140,7 @@ void RTCIceTransport::OnGatheringStateChanged(cricket::IceTransportInternal*) {
     auto env = Env();
     Napi::HandleScope scope(env);
     auto event = Napi::Object::New(env);
-    event.Set("type", Napi::String::New(env, "gatheringstatechange"));
+    event.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "gatheringstatechange"));
     MakeCallback("dispatchEvent", { event });
   }));
 }
@@ -207,6 +208,7 @@ Napi::Value RTCIceTransport::GetRemoteParameters(const Napi::CallbackInfo& info)
 
 void RTCIceTransport::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(env, "RTCIceTransport", {
+    InstanceMethod("getQueueMetrics", &RTCIceTransport::GetQueueMetrics),
     InstanceAccessor("role", &RTCIceTransport::GetRole, nullptr),
     InstanceAccessor("component", &RTCIceTransport::GetComponent, nullptr),
     InstanceAccessor("state", &RTCIceTransport::GetState, nullptr),
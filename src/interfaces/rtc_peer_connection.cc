@@ -9,15 +9,20 @@
  */
 #include "src/interfaces/rtc_peer_connection.h"
 
+#include <algorithm>
 #include <iosfwd>
 #include <assert.h>
 
+#include <webrtc/api/jsep_ice_candidate.h>
 #include <webrtc/api/media_types.h>
 #include <webrtc/api/peer_connection_interface.h>
 #include <webrtc/api/rtc_error.h>
 #include <webrtc/api/rtp_transceiver_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/p2p/client/basic_port_allocator.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/time_utils.h>
 
 #include "src/converters.h"
 #include "src/converters/arguments.h"
@@ -25,6 +30,7 @@
 #include "src/converters/napi.h"
 #include "src/dictionaries/macros/napi.h"
 #include "src/dictionaries/node_webrtc/rtc_answer_options.h"
+#include "src/dictionaries/node_webrtc/rtc_ice_tuning.h"
 #include "src/dictionaries/node_webrtc/rtc_offer_options.h"
 #include "src/dictionaries/node_webrtc/rtc_session_description_init.h"
 #include "src/dictionaries/node_webrtc/some_error.h"
@@ -42,6 +48,7 @@
 #include "src/functional/maybe.h"
 #include "src/interfaces/media_stream.h"
 #include "src/interfaces/media_stream_track.h"
+#include "src/interfaces/rtc_certificate.h"
 #include "src/interfaces/rtc_data_channel.h"
 #include "src/interfaces/rtc_peer_connection/create_session_description_observer.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
@@ -56,6 +63,7 @@
 #include "src/node/events.h"
 #include "src/node/promise.h"
 #include "src/node/utility.h"
+#include "src/webrtc/certificate_pool.h"
 
 namespace node_webrtc {
 
@@ -77,34 +85,38 @@ namespace node_webrtc {
 			return;
 		}
 
-		CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(info, maybeConfiguration, Maybe<ExtendedRTCConfiguration>)
+		CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(info, args, std::tuple<Maybe<ExtendedRTCConfiguration> COMMA Maybe<bool>>)
 
-		auto configuration = maybeConfiguration.FromMaybe(ExtendedRTCConfiguration());
+		auto configuration = std::get<0>(args).FromMaybe(ExtendedRTCConfiguration());
 
 		if (!validateConfiguration(configuration.configuration)) {
 			Napi::TypeError::New(info.Env(), "The given configuration is invalid.").ThrowAsJavaScriptException();
 			return;
 		}
 
+		auto now = static_cast<uint64_t>(rtc::TimeUTCMillis());
+		for (const auto& certificate : configuration.configuration.certificates) {
+			if (certificate->HasExpired(now)) {
+				Napi::Error(env, ErrorFactory::CreateInvalidAccessError(env, "The certificate has expired")).ThrowAsJavaScriptException();
+				return;
+			}
+		}
+
 		// TODO(mroberts): Read `factory` (non-standard) from RTCConfiguration?
 		_factory = PeerConnectionFactory::GetOrCreateDefault();
 		_shouldReleaseFactory = true;
-
-		auto portAllocator = std::unique_ptr<cricket::PortAllocator>(new cricket::BasicPortAllocator(
-			_factory->getNetworkManager(),
-			_factory->getSocketFactory()));
 		_port_range = configuration.portRange;
-		portAllocator->SetPortRange(
-			_port_range.min.FromMaybe(0),
-			_port_range.max.FromMaybe(65535));
+		_portAllocatorFlags = configuration.portAllocatorFlags;
+		_iceCandidatePoolSize = configuration.configuration.ice_candidate_pool_size;
 
-		webrtc::PeerConnectionDependencies deps(this);
-		deps.allocator = std::move(portAllocator);
-		deps.cert_generator = nullptr;
+		// RTCPeerConnection.create() passes true here, and then calls _create() to create the underlying
+		// PeerConnection on the signaling thread.
+		if (std::get<1>(args).FromMaybe(false)) {
+			_pendingConfiguration.reset(new webrtc::PeerConnectionInterface::RTCConfiguration(configuration.configuration));
+			return;
+		}
 
-		auto result = _factory->factory()->CreatePeerConnectionOrError(
-			configuration.configuration,
-			std::move(deps));
+		auto result = CreateJinglePeerConnection(configuration.configuration);
 		
 		if (!result.ok()) {
 			CONVERT_OR_THROW_AND_RETURN_VOID_NAPI(env, &result.error(), error, Napi::Value)
@@ -112,15 +124,110 @@ namespace node_webrtc {
 			return;
 		}
 
-		_jinglePeerConnection = result.MoveValue();
-		_cached_configuration = ExtendedRTCConfiguration(
-			_jinglePeerConnection->GetConfiguration(),
-			_port_range);
+		auto peerConnection = result.MoveValue();
+		DidCreateJinglePeerConnection(peerConnection, peerConnection->GetConfiguration());
 		// Now that we have an underlying PeerConnection allocated, this object must stay alive until its status becomes 
 		// "closed"
 		// https://w3c.github.io/webrtc-pc/#garbage-collection
 	}
 
+	webrtc::RTCErrorOr<rtc::scoped_refptr<webrtc::PeerConnectionInterface>> RTCPeerConnection::CreateJinglePeerConnection(
+		const webrtc::PeerConnectionInterface::RTCConfiguration& configuration) {
+		auto configurationWithCertificate = configuration;
+
+		// A warm allocator has a pooled session that is already gathering. PeerConnection discards pooled sessions
+		// beyond its iceCandidatePoolSize, so keep room for it.
+		auto portAllocatorFlags = _portAllocatorFlags | _factory->portAllocatorFlags();
+		auto portAllocator = _factory->TakeWarmPortAllocator(configuration, _port_range, portAllocatorFlags);
+		if (portAllocator) {
+			_tookWarmPortAllocator = true;
+			configurationWithCertificate.ice_candidate_pool_size = std::max(configuration.ice_candidate_pool_size, 1);
+		} else {
+			portAllocator = std::unique_ptr<cricket::PortAllocator>(new cricket::BasicPortAllocator(
+				_factory->getNetworkManager(),
+				_factory->getSocketFactory()));
+			portAllocator->SetPortRange(
+				_port_range.min.FromMaybe(0),
+				_port_range.max.FromMaybe(65535));
+			// PeerConnection adds its own flags to these.
+			portAllocator->set_flags(portAllocator->flags() | portAllocatorFlags);
+		}
+
+		webrtc::PeerConnectionDependencies deps(this);
+		deps.allocator = std::move(portAllocator);
+		deps.cert_generator = nullptr;
+
+		// Without certificates, libwebrtc generates one while creating the first offer or answer. Take one from the
+		// CertificatePool instead, if it has one ready.
+		if (configurationWithCertificate.certificates.empty()) {
+			auto certificate = CertificatePool::Get()->Take();
+			if (certificate) {
+				configurationWithCertificate.certificates.push_back(certificate);
+			}
+		}
+
+		return _factory->factory()->CreatePeerConnectionOrError(
+			configurationWithCertificate,
+			std::move(deps));
+	}
+
+	void RTCPeerConnection::DidCreateJinglePeerConnection(
+		rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection,
+		const webrtc::PeerConnectionInterface::RTCConfiguration& configuration) {
+		_snapshotMutex.lock();
+		_jinglePeerConnection = peerConnection;
+		_snapshotMutex.unlock();
+		CacheConfiguration(configuration);
+		_sdpSemantics = configuration.sdp_semantics;
+	}
+
+	void RTCPeerConnection::CacheConfiguration(const webrtc::PeerConnectionInterface::RTCConfiguration& configuration) {
+		_cached_configuration = ExtendedRTCConfiguration(configuration, _port_range);
+		// Report the iceCandidatePoolSize asked for, rather than the one a warm allocator raised it to.
+		_cached_configuration.configuration.ice_candidate_pool_size = _iceCandidatePoolSize;
+	}
+
+	Napi::Value RTCPeerConnection::Create(const Napi::CallbackInfo& info) {
+		auto env = info.Env();
+		CREATE_DEFERRED(env, deferred)
+
+		if (!_factory || !_pendingConfiguration) {
+			Reject(deferred, ErrorFactory::CreateInvalidStateError(env, "The RTCPeerConnection has already been created"));
+			return deferred.Promise();
+		}
+
+		std::shared_ptr<webrtc::PeerConnectionInterface::RTCConfiguration> configuration(std::move(_pendingConfiguration));
+		_factory->_signalingThread->PostTask(RTC_FROM_HERE, [this, deferred, configuration]() {
+			// We are on the signaling thread, so the factory creates the PeerConnection (and its certificate)
+			// without blocking the main thread, and GetConfiguration does not hop. The main thread reads the
+			// members DidCreateJinglePeerConnection sets without a lock, so it sets them there.
+			auto result = CreateJinglePeerConnection(*configuration);
+			if (result.ok()) {
+				auto peerConnection = result.MoveValue();
+				auto created = std::make_shared<webrtc::PeerConnectionInterface::RTCConfiguration>(
+					peerConnection->GetConfiguration());
+				Dispatch(CreatePromise<RTCPeerConnection>(deferred, [this, peerConnection, created](auto deferred) {
+					DidCreateJinglePeerConnection(peerConnection, *created);
+					Resolve(deferred, this->Env().Undefined());
+				}));
+				return;
+			}
+			auto error = std::make_shared<webrtc::RTCError>(result.MoveError());
+			Dispatch(CreatePromise<RTCPeerConnection>(deferred, [this, error](auto deferred) {
+				Reject(deferred, error.get());
+				if (_factory) {
+					if (_shouldReleaseFactory) {
+						PeerConnectionFactory::Release();
+					}
+					_factory = nullptr;
+				}
+				Stop();
+			}));
+		});
+
+		return deferred.Promise();
+	}
+
 	void RTCPeerConnection::Finalize(Napi::Env env) {
 		if (_factory) {
 			if (_shouldReleaseFactory) {
@@ -131,6 +238,11 @@ namespace node_webrtc {
 	}
 
 	void RTCPeerConnection::OnSignalingChange(webrtc::PeerConnectionInterface::SignalingState state) {
+		_snapshotMutex.lock();
+		_snapshot.signalingState = state;
+		_snapshotMutex.unlock();
+		TakeDescriptionSnapshot(true, true);
+
 		Dispatch(CreateCallback<RTCPeerConnection>([this, state]() {
 			MakeCallback("_onsignalingstatechange", {});
 			if (state == webrtc::PeerConnectionInterface::kClosed) {
@@ -140,49 +252,78 @@ namespace node_webrtc {
 	}
 
 	void RTCPeerConnection::OnIceConnectionChange(webrtc::PeerConnectionInterface::IceConnectionState) {
+		// The legacy state; "iceconnectionstatechange" follows the standardized one, below.
+	}
+
+	void RTCPeerConnection::OnStandardizedIceConnectionChange(webrtc::PeerConnectionInterface::IceConnectionState state) {
+		// Update the snapshot before queueing the event, so that listeners read the new state.
+		_snapshotMutex.lock();
+		_snapshot.iceConnectionState = state;
+		_snapshotMutex.unlock();
+
 		Dispatch(CreateCallback<RTCPeerConnection>([this]() {
 			MakeCallback("_oniceconnectionstatechange", {});
+			}));
+	}
+
+	void RTCPeerConnection::OnConnectionChange(webrtc::PeerConnectionInterface::PeerConnectionState state) {
+		_snapshotMutex.lock();
+		_snapshot.connectionState = state;
+		_snapshotMutex.unlock();
+
+		Dispatch(CreateCallback<RTCPeerConnection>([this]() {
 			MakeCallback("_onconnectionstatechange", {});
 			}));
 	}
 
-	void RTCPeerConnection::OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState) {
+	void RTCPeerConnection::OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState state) {
+		_snapshotMutex.lock();
+		_snapshot.iceGatheringState = state;
+		_snapshotMutex.unlock();
+
 		Dispatch(CreateCallback<RTCPeerConnection>([this]() {
 			MakeCallback("_onicegatheringstatechange", {});
 			}));
 	}
 
 	void RTCPeerConnection::OnIceCandidate(const webrtc::IceCandidateInterface* ice_candidate) {
-		std::string error;
+		// libwebrtc has already added the candidate to the local description. Re-serializing it for every
+		// candidate would make gathering quadratic, so only mark the snapshot stale; the getters refresh it.
+		_snapshotMutex.lock();
+		_snapshot.localDescriptionsStale = true;
+		_snapshotMutex.unlock();
+
+		// Copy the cricket::Candidate rather than printing and re-parsing it; the converter prints it once, on the
+		// main thread.
+		auto candidate = std::unique_ptr<webrtc::IceCandidateInterface>(new webrtc::JsepIceCandidate(
+			ice_candidate->sdp_mid(),
+			ice_candidate->sdp_mline_index(),
+			ice_candidate->candidate()));
 
-		std::string sdp;
-		if (!ice_candidate->ToString(&sdp)) {
-			error = "Failed to print the candidate string. This is pretty weird. "
-					"File a bug on https://github.com/cubicleai/wrtc";
+		_iceCandidatesMutex.lock();
+		auto first = _iceCandidates.empty();
+		_iceCandidates.push_back(std::move(candidate));
+		_iceCandidatesMutex.unlock();
+		if (!first) {
 			return;
 		}
 
-		webrtc::SdpParseError parseError;
-		auto candidate = std::shared_ptr<webrtc::IceCandidateInterface>(webrtc::CreateIceCandidate(
-			ice_candidate->sdp_mid(),
-			ice_candidate->sdp_mline_index(),
-			sdp,
-			&parseError));
-		if (!parseError.description.empty()) {
-			error = parseError.description;
-		}
-		else if (!candidate) {
-			error = "Failed to copy RTCIceCandidate";
-		}
+		Dispatch(CreateCallback<RTCPeerConnection>([this]() {
+			_iceCandidatesMutex.lock();
+			auto candidates = std::move(_iceCandidates);
+			_iceCandidates.clear();
+			_iceCandidatesMutex.unlock();
 
-		Dispatch(CreateCallback<RTCPeerConnection>([this, candidate, error]() {
-			if (error.empty()) {
-				auto env = Env();
+			auto env = Env();
+			auto array = Napi::Array::New(env);
+			uint32_t i = 0;
+			for (const auto& candidate : candidates) {
 				auto maybeCandidate = From<Napi::Value>(std::make_pair(env, candidate.get()));
 				if (maybeCandidate.IsValid()) {
-					MakeCallback("_onicecandidate", { maybeCandidate.UnsafeFromValid() });
+					array.Set(i++, maybeCandidate.UnsafeFromValid());
 				}
 			}
+			MakeCallback("_onicecandidates", { array });
 			}));
 	}
 
@@ -229,7 +370,7 @@ namespace node_webrtc {
 
 	void RTCPeerConnection::OnAddTrack(rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver,
 		const std::vector<rtc::scoped_refptr<webrtc::MediaStreamInterface>>& streams) {
-		if (_jinglePeerConnection->GetConfiguration().sdp_semantics != webrtc::SdpSemantics::kPlanB) {
+		if (_sdpSemantics != webrtc::SdpSemantics::kPlanB) {
 			return;
 		}
 		Dispatch(CreateCallback<RTCPeerConnection>([this, receiver, streams]() {
@@ -339,7 +480,7 @@ namespace node_webrtc {
 		if (!_factory || !_jinglePeerConnection) {
 			Napi::Error::New(env, "Cannot addTransceiver; RTCPeerConnection is closed").ThrowAsJavaScriptException();
 			return env.Undefined();
-		} else if (_jinglePeerConnection->GetConfiguration().sdp_semantics != webrtc::SdpSemantics::kUnifiedPlan) {
+		} else if (_sdpSemantics != webrtc::SdpSemantics::kUnifiedPlan) {
 			Napi::Error::New(env, "AddTransceiver is only available with Unified Plan SdpSemanticsAbort").ThrowAsJavaScriptException();
 			return env.Undefined();
 		}
@@ -430,7 +571,7 @@ namespace node_webrtc {
 			return deferred.Promise();
 		}
 
-		if (!_jinglePeerConnection || _jinglePeerConnection->signaling_state() == webrtc::PeerConnectionInterface::SignalingState::kClosed) {
+		if (isSignalingClosed()) {
 			Reject(deferred, ErrorFactory::CreateInvalidStateError(env,
 				"Failed to execute 'createOffer' on 'RTCPeerConnection': "
 				"The RTCPeerConnection's signalingState is 'closed'."));
@@ -455,7 +596,7 @@ namespace node_webrtc {
 			return deferred.Promise();
 		}
 
-		if (!_jinglePeerConnection || _jinglePeerConnection->signaling_state() == webrtc::PeerConnectionInterface::SignalingState::kClosed) {
+		if (isSignalingClosed()) {
 			Reject(deferred, ErrorFactory::CreateInvalidStateError(env,
 				"Failed to execute 'createAnswer' on 'RTCPeerConnection': "
 				"The RTCPeerConnection's signalingState is 'closed'."));
@@ -485,7 +626,7 @@ namespace node_webrtc {
 		auto rawDescription = maybeRawDescription.UnsafeFromValid();
 		std::unique_ptr<webrtc::SessionDescriptionInterface> description(rawDescription);
 
-		if (!_jinglePeerConnection || _jinglePeerConnection->signaling_state() == webrtc::PeerConnectionInterface::SignalingState::kClosed) {
+		if (isSignalingClosed()) {
 			Reject(deferred, ErrorFactory::CreateInvalidStateError(env,
 				"Failed to execute 'setLocalDescription' on 'RTCPeerConnection': "
 				"The RTCPeerConnection's signalingState is 'closed'."));
@@ -505,7 +646,7 @@ namespace node_webrtc {
 			CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, rawDescription, webrtc::SessionDescriptionInterface*)
 			std::unique_ptr<webrtc::SessionDescriptionInterface> description(rawDescription);
 
-		if (!_jinglePeerConnection || _jinglePeerConnection->signaling_state() == webrtc::PeerConnectionInterface::SignalingState::kClosed) {
+		if (isSignalingClosed()) {
 			Reject(deferred, ErrorFactory::CreateInvalidStateError(env,
 				"Failed to execute 'setRemoteDescription' on 'RTCPeerConnection': "
 				"The RTCPeerConnection's signalingState is 'closed'."));
@@ -525,15 +666,20 @@ namespace node_webrtc {
 			CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, candidate, std::shared_ptr<webrtc::IceCandidateInterface>)
 
 			Dispatch(CreatePromise<RTCPeerConnection>(deferred, [this, candidate](auto deferred) {
-			if (_jinglePeerConnection
-				&& _jinglePeerConnection->signaling_state() != webrtc::PeerConnectionInterface::SignalingState::kClosed
-				&& _jinglePeerConnection->AddIceCandidate(candidate.get())) {
+			auto closed = isSignalingClosed();
+			// Add the candidate and snapshot the remote description it was added to in a single hop.
+			if (!closed && _factory->_signalingThread->Invoke<bool>(RTC_FROM_HERE, [this, &candidate]() {
+					auto added = _jinglePeerConnection->AddIceCandidate(candidate.get());
+					if (added) {
+						TakeDescriptionSnapshot(false, true);
+					}
+					return added;
+				})) {
 				Resolve(deferred, this->Env().Undefined());
 			}
 			else {
 				std::string error = std::string("Failed to set ICE candidate");
-				if (!_jinglePeerConnection
-					|| _jinglePeerConnection->signaling_state() == webrtc::PeerConnectionInterface::SignalingState::kClosed) {
+				if (closed) {
 					error += "; RTCPeerConnection is closed";
 				}
 				error += ".";
@@ -574,10 +720,7 @@ namespace node_webrtc {
 	}
 
 	Napi::Value RTCPeerConnection::GetConfiguration(const Napi::CallbackInfo& info) {
-		auto configuration = _jinglePeerConnection
-			? ExtendedRTCConfiguration(_jinglePeerConnection->GetConfiguration(), _port_range)
-			: _cached_configuration;
-		CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), configuration, result, Napi::Value)
+		CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _cached_configuration, result, Napi::Value)
 			return result;
 	}
 
@@ -598,6 +741,7 @@ namespace node_webrtc {
 		auto env = info.Env();
 
 		CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, configuration, webrtc::PeerConnectionInterface::RTCConfiguration)
+		CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, tuning, RTCIceTuning)
 
 		if (!validateConfiguration(configuration)) {
 			Napi::TypeError::New(info.Env(), "The given configuration is invalid.").ThrowAsJavaScriptException();
@@ -609,6 +753,22 @@ namespace node_webrtc {
 			return env.Undefined();
 		}
 
+		// The certificates cannot change, but they may be omitted.
+		if (configuration.certificates.empty()) {
+			configuration.certificates = _cached_configuration.configuration.certificates;
+		}
+
+		// Omitted RTCIceTuning members keep their current values; libwebrtc rejects changes to some of them.
+		CopyRTCIceTuning(_cached_configuration.configuration, &configuration);
+		ApplyRTCIceTuning(tuning, &configuration);
+
+		// After setLocalDescription, libwebrtc rejects any change to iceCandidatePoolSize, so keep the room made for a
+		// warm allocator's pooled session.
+		auto iceCandidatePoolSize = configuration.ice_candidate_pool_size;
+		if (_tookWarmPortAllocator) {
+			configuration.ice_candidate_pool_size = std::max(iceCandidatePoolSize, 1);
+		}
+
 		auto rtcError = _jinglePeerConnection->SetConfiguration(configuration);
 		if (!rtcError.ok()) {
 			CONVERT_OR_THROW_AND_RETURN_NAPI(env, &rtcError, error, Napi::Value)
@@ -617,6 +777,10 @@ namespace node_webrtc {
 			return env.Undefined();
 		}
 
+		// libwebrtc ignores or rejects some of the members set, so read back what it applied.
+		_iceCandidatePoolSize = iceCandidatePoolSize;
+		CacheConfiguration(_jinglePeerConnection->GetConfiguration());
+
 		return env.Undefined();
 	}
 
@@ -687,8 +851,7 @@ namespace node_webrtc {
 
 	Napi::Value RTCPeerConnection::GetTransceivers(const Napi::CallbackInfo& info) {
 		std::vector<RTCRtpTransceiver*> transceivers;
-		if (_jinglePeerConnection
-			&& _jinglePeerConnection->GetConfiguration().sdp_semantics == webrtc::SdpSemantics::kUnifiedPlan) {
+		if (isUnifiedPlan()) {
 			for (const auto& transceiver : _jinglePeerConnection->GetTransceivers()) {
 				auto wrappedTransceiver = createOrUpdateTransceiver(transceiver);
 				transceivers.emplace_back(wrappedTransceiver);
@@ -704,9 +867,7 @@ namespace node_webrtc {
 
 	Napi::Value RTCPeerConnection::Close(const Napi::CallbackInfo& info) {
 		if (_jinglePeerConnection) {
-			_cached_configuration = ExtendedRTCConfiguration(
-				_jinglePeerConnection->GetConfiguration(),
-				_port_range);
+			CacheConfiguration(_jinglePeerConnection->GetConfiguration());
 
 			// Now that we are in a closed state, it is OK for us to be garbage collected.
 			// Note however that if any MediaStreamTracks or DataChannels were created, those will 
@@ -722,7 +883,7 @@ namespace node_webrtc {
 			// NOTE(mroberts): Perhaps another way to do this is to just register all remote MediaStreamTracks against this
 			// RTCPeerConnection, not unlike what we do with RTCDataChannels.
 
-			if (_jinglePeerConnection->GetConfiguration().sdp_semantics == webrtc::SdpSemantics::kUnifiedPlan) {
+			if (_sdpSemantics == webrtc::SdpSemantics::kUnifiedPlan) {
 				for (auto pair : _tracks) { // Should this be _peerTracks?
 					pair.second->OnPeerConnectionClosed();
 				}
@@ -733,7 +894,12 @@ namespace node_webrtc {
 			}
 		}
 
-		_jinglePeerConnection = nullptr;
+		// Release the PeerConnection after unlocking: dropping the last reference blocks on the signaling thread,
+		// which may itself be waiting for the mutex (e.g., in TakeDescriptionSnapshot or OnIceCandidate).
+		_snapshotMutex.lock();
+		auto peerConnection = std::move(_jinglePeerConnection);
+		_snapshotMutex.unlock();
+		peerConnection = nullptr;
 
 		if (_factory) {
 			if (_shouldReleaseFactory) {
@@ -814,72 +980,38 @@ namespace node_webrtc {
 	Napi::Value RTCPeerConnection::GetConnectionState(const Napi::CallbackInfo& info) {
 		auto env = info.Env();
 
-		auto connectionState = _jinglePeerConnection
-			? _jinglePeerConnection->peer_connection_state()
-			: webrtc::PeerConnectionInterface::PeerConnectionState::kClosed;
+		auto connectionState = webrtc::PeerConnectionInterface::PeerConnectionState::kClosed;
+		if (_jinglePeerConnection) {
+			std::lock_guard<std::mutex> lock(_snapshotMutex);
+			connectionState = _snapshot.connectionState;
+		}
 
 		CONVERT_OR_THROW_AND_RETURN_NAPI(env, connectionState, result, Napi::Value)
 			return result;
 	}
 
 	Napi::Value RTCPeerConnection::GetCurrentLocalDescription(const Napi::CallbackInfo& info) {
-		auto env = info.Env();
-		Napi::Value result = env.Null();
-		if (_jinglePeerConnection && _jinglePeerConnection->current_local_description()) {
-			CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->current_local_description(), description, Napi::Value)
-				result = description;
-		}
-		return result;
+		return GetSnapshotDescription(info.Env(), &Snapshot::currentLocalDescription, true);
 	}
 
 	Napi::Value RTCPeerConnection::GetLocalDescription(const Napi::CallbackInfo& info) {
-		auto env = info.Env();
-		Napi::Value result = env.Null();
-		if (_jinglePeerConnection && _jinglePeerConnection->local_description()) {
-			CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->local_description(), description, Napi::Value)
-				result = description;
-		}
-		return result;
+		return GetSnapshotDescription(info.Env(), &Snapshot::localDescription, true);
 	}
 
 	Napi::Value RTCPeerConnection::GetPendingLocalDescription(const Napi::CallbackInfo& info) {
-		auto env = info.Env();
-		Napi::Value result = env.Null();
-		if (_jinglePeerConnection && _jinglePeerConnection->pending_local_description()) {
-			CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->pending_local_description(), description, Napi::Value)
-				result = description;
-		}
-		return result;
+		return GetSnapshotDescription(info.Env(), &Snapshot::pendingLocalDescription, true);
 	}
 
 	Napi::Value RTCPeerConnection::GetCurrentRemoteDescription(const Napi::CallbackInfo& info) {
-		auto env = info.Env();
-		Napi::Value result = env.Null();
-		if (_jinglePeerConnection && _jinglePeerConnection->current_remote_description()) {
-			CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->current_remote_description(), description, Napi::Value)
-				result = description;
-		}
-		return result;
+		return GetSnapshotDescription(info.Env(), &Snapshot::currentRemoteDescription, false);
 	}
 
 	Napi::Value RTCPeerConnection::GetRemoteDescription(const Napi::CallbackInfo& info) {
-		auto env = info.Env();
-		Napi::Value result = env.Null();
-		if (_jinglePeerConnection && _jinglePeerConnection->remote_description()) {
-			CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->remote_description(), description, Napi::Value)
-				result = description;
-		}
-		return result;
+		return GetSnapshotDescription(info.Env(), &Snapshot::remoteDescription, false);
 	}
 
 	Napi::Value RTCPeerConnection::GetPendingRemoteDescription(const Napi::CallbackInfo& info) {
-		auto env = info.Env();
-		Napi::Value result = env.Null();
-		if (_jinglePeerConnection && _jinglePeerConnection->pending_remote_description()) {
-			CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->pending_remote_description(), description, Napi::Value)
-				result = description;
-		}
-		return result;
+		return GetSnapshotDescription(info.Env(), &Snapshot::pendingRemoteDescription, false);
 	}
 
 	Napi::Value RTCPeerConnection::GetSctp(const Napi::CallbackInfo& info) {
@@ -893,25 +1025,31 @@ namespace node_webrtc {
 	}
 
 	Napi::Value RTCPeerConnection::GetSignalingState(const Napi::CallbackInfo& info) {
-		auto signalingState = _jinglePeerConnection
-			? _jinglePeerConnection->signaling_state()
-			: webrtc::PeerConnectionInterface::SignalingState::kClosed;
+		auto signalingState = webrtc::PeerConnectionInterface::SignalingState::kClosed;
+		if (_jinglePeerConnection) {
+			std::lock_guard<std::mutex> lock(_snapshotMutex);
+			signalingState = _snapshot.signalingState;
+		}
 		CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), signalingState, result, Napi::Value)
 			return result;
 	}
 
 	Napi::Value RTCPeerConnection::GetIceConnectionState(const Napi::CallbackInfo& info) {
-		auto iceConnectionState = _jinglePeerConnection
-			? _jinglePeerConnection->standardized_ice_connection_state()
-			: webrtc::PeerConnectionInterface::IceConnectionState::kIceConnectionClosed;
+		auto iceConnectionState = webrtc::PeerConnectionInterface::IceConnectionState::kIceConnectionClosed;
+		if (_jinglePeerConnection) {
+			std::lock_guard<std::mutex> lock(_snapshotMutex);
+			iceConnectionState = _snapshot.iceConnectionState;
+		}
 		CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), iceConnectionState, result, Napi::Value)
 			return result;
 	}
 
 	Napi::Value RTCPeerConnection::GetIceGatheringState(const Napi::CallbackInfo& info) {
-		auto iceGatheringState = _jinglePeerConnection
-			? _jinglePeerConnection->ice_gathering_state()
-			: webrtc::PeerConnectionInterface::IceGatheringState::kIceGatheringComplete;
+		auto iceGatheringState = webrtc::PeerConnectionInterface::IceGatheringState::kIceGatheringComplete;
+		if (_jinglePeerConnection) {
+			std::lock_guard<std::mutex> lock(_snapshotMutex);
+			iceGatheringState = _snapshot.iceGatheringState;
+		}
 		CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), iceGatheringState, result, Napi::Value)
 			return result;
 	}
@@ -1065,8 +1203,71 @@ namespace node_webrtc {
 		this->_lastSdp = lastSdp;
 	}
 
+	bool RTCPeerConnection::isSignalingClosed() {
+		std::lock_guard<std::mutex> lock(_snapshotMutex);
+		return !_jinglePeerConnection
+			|| _snapshot.signalingState == webrtc::PeerConnectionInterface::SignalingState::kClosed;
+	}
+
+	static Maybe<RTCSessionDescriptionInit> CopyDescription(const webrtc::SessionDescriptionInterface* description) {
+		if (!description) {
+			return MakeNothing<RTCSessionDescriptionInit>();
+		}
+		auto maybeInit = From<RTCSessionDescriptionInit>(description);
+		return maybeInit.IsValid()
+			? MakeJust(maybeInit.UnsafeFromValid())
+			: MakeNothing<RTCSessionDescriptionInit>();
+	}
+
+	void RTCPeerConnection::TakeDescriptionSnapshot(bool local, bool remote) {
+		std::lock_guard<std::mutex> lock(_snapshotMutex);
+		if (!_jinglePeerConnection) {
+			return;
+		}
+		// We are on the signaling thread, so these calls do not hop.
+		if (local) {
+			_snapshot.localDescriptionsStale = false;
+			_snapshot.currentLocalDescription = CopyDescription(_jinglePeerConnection->current_local_description());
+			_snapshot.localDescription = CopyDescription(_jinglePeerConnection->local_description());
+			_snapshot.pendingLocalDescription = CopyDescription(_jinglePeerConnection->pending_local_description());
+		}
+		if (remote) {
+			_snapshot.currentRemoteDescription = CopyDescription(_jinglePeerConnection->current_remote_description());
+			_snapshot.remoteDescription = CopyDescription(_jinglePeerConnection->remote_description());
+			_snapshot.pendingRemoteDescription = CopyDescription(_jinglePeerConnection->pending_remote_description());
+		}
+	}
+
+	Napi::Value RTCPeerConnection::GetSnapshotDescription(
+		Napi::Env env,
+		Maybe<RTCSessionDescriptionInit> Snapshot::* member,
+		bool local) {
+		if (!_jinglePeerConnection) {
+			return env.Null();
+		}
+		_snapshotMutex.lock();
+		auto stale = local && _snapshot.localDescriptionsStale;
+		_snapshotMutex.unlock();
+		if (stale && _factory) {
+			// Candidates were gathered since the last snapshot; take one hop to catch up on all of them.
+			_factory->_signalingThread->Invoke<void>(RTC_FROM_HERE, [this]() {
+				TakeDescriptionSnapshot(true, false);
+			});
+		}
+		_snapshotMutex.lock();
+		auto maybeDescription = _snapshot.*member;
+		_snapshotMutex.unlock();
+		if (maybeDescription.IsNothing()) {
+			return env.Null();
+		}
+		CONVERT_OR_THROW_AND_RETURN_NAPI(env, maybeDescription.UnsafeFromJust(), description, Napi::Value)
+		return description;
+	}
+
 	void node_webrtc::RTCPeerConnection::onSetDescriptionComplete()
 	{
+		TakeDescriptionSnapshot(true, true);
+
 		Dispatch(CreateCallback<RTCPeerConnection>([this]() {
 			if (!_jinglePeerConnection)
 				return;
@@ -1122,6 +1323,9 @@ namespace node_webrtc {
 
 	void RTCPeerConnection::Init(Napi::Env env, Napi::Object exports) {
 		auto func = DefineClass(env, "RTCPeerConnection", {
+		  StaticMethod("generateCertificate", &RTCCertificate::GenerateCertificate),
+		  InstanceMethod("getQueueMetrics", &RTCPeerConnection::GetQueueMetrics),
+		  InstanceMethod("_create", &RTCPeerConnection::Create),
 		  InstanceMethod("addTrack", &RTCPeerConnection::AddTrack),
 		  InstanceMethod("addTransceiver", &RTCPeerConnection::AddTransceiver),
 		  InstanceMethod("removeTrack", &RTCPeerConnection::RemoveTrack),
@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <node-addon-api/napi.h>
@@ -18,6 +20,7 @@
 #include "src/node/async_object_wrap_with_loop.h"
 #include "src/dictionaries/node_webrtc/extended_rtc_configuration.h"
 #include "src/dictionaries/node_webrtc/rtc_session_description_init.h"
+#include "src/functional/maybe.h"
 #include "src/interfaces/rtc_rtp_transceiver.h"
 #include "src/interfaces/rtc_rtp_receiver.h"
 #include "src/interfaces/rtc_rtp_sender.h"
@@ -54,6 +57,8 @@ namespace node_webrtc {
 		//
 		void OnSignalingChange(webrtc::PeerConnectionInterface::SignalingState new_state) override;
 		void OnIceConnectionChange(webrtc::PeerConnectionInterface::IceConnectionState new_state) override;
+		void OnStandardizedIceConnectionChange(webrtc::PeerConnectionInterface::IceConnectionState new_state) override;
+		void OnConnectionChange(webrtc::PeerConnectionInterface::PeerConnectionState new_state) override;
 		void OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState new_state) override;
 		void OnIceCandidate(const webrtc::IceCandidateInterface* candidate) override;
 		void OnIceCandidateError(const std::string& host_candidate, const std::string& url, int error_code, const std::string& error_text) override;
@@ -87,19 +92,67 @@ namespace node_webrtc {
 		void processStateChangesPlanB();
 		void processStateChangesUnifiedPlan();
 		bool validateConfiguration(webrtc::PeerConnectionInterface::RTCConfiguration configuration);
+
+		webrtc::RTCErrorOr<rtc::scoped_refptr<webrtc::PeerConnectionInterface>> CreateJinglePeerConnection(
+			const webrtc::PeerConnectionInterface::RTCConfiguration&);
+		/**
+		 * Publish the PeerConnection and the configuration it was created with. Call this on the main thread.
+		 */
+		void DidCreateJinglePeerConnection(
+			rtc::scoped_refptr<webrtc::PeerConnectionInterface>,
+			const webrtc::PeerConnectionInterface::RTCConfiguration&);
+		void CacheConfiguration(const webrtc::PeerConnectionInterface::RTCConfiguration&);
 		
 		inline bool isPlanB() { 
 			return _jinglePeerConnection 
-				? (_jinglePeerConnection->GetConfiguration().sdp_semantics == webrtc::SdpSemantics::kPlanB) 
+				? (_sdpSemantics == webrtc::SdpSemantics::kPlanB) 
 				: false; 
 		}
 
 		inline bool isUnifiedPlan() { 
 			return _jinglePeerConnection
-				? (_jinglePeerConnection->GetConfiguration().sdp_semantics == webrtc::SdpSemantics::kUnifiedPlan)
+				? (_sdpSemantics == webrtc::SdpSemantics::kUnifiedPlan)
 				: false;
 		}
 
+		/**
+		 * The state our getters report. libwebrtc's PeerConnectionInterface is a proxy, and every call made
+		 * through it from the main thread blocks on a hop to the signaling thread. So instead, the observer
+		 * callbacks (which run on the signaling thread) keep this snapshot up to date, and the getters read it.
+		 */
+		struct Snapshot {
+			webrtc::PeerConnectionInterface::SignalingState signalingState =
+				webrtc::PeerConnectionInterface::SignalingState::kStable;
+			webrtc::PeerConnectionInterface::IceConnectionState iceConnectionState =
+				webrtc::PeerConnectionInterface::IceConnectionState::kIceConnectionNew;
+			webrtc::PeerConnectionInterface::PeerConnectionState connectionState =
+				webrtc::PeerConnectionInterface::PeerConnectionState::kNew;
+			webrtc::PeerConnectionInterface::IceGatheringState iceGatheringState =
+				webrtc::PeerConnectionInterface::IceGatheringState::kIceGatheringNew;
+			Maybe<RTCSessionDescriptionInit> currentLocalDescription;
+			Maybe<RTCSessionDescriptionInit> localDescription;
+			Maybe<RTCSessionDescriptionInit> pendingLocalDescription;
+			Maybe<RTCSessionDescriptionInit> currentRemoteDescription;
+			Maybe<RTCSessionDescriptionInit> remoteDescription;
+			Maybe<RTCSessionDescriptionInit> pendingRemoteDescription;
+			// Set when a gathered candidate has changed the local descriptions since they were copied.
+			bool localDescriptionsStale = false;
+		};
+
+		bool isSignalingClosed();
+
+		/**
+		 * Copy the local and/or remote descriptions into the snapshot. Call this on the signaling thread.
+		 */
+		void TakeDescriptionSnapshot(bool local, bool remote);
+
+		/**
+		 * Read a description from the snapshot. Local descriptions made stale by gathered candidates are
+		 * copied again first.
+		 */
+		Napi::Value GetSnapshotDescription(Napi::Env, Maybe<RTCSessionDescriptionInit> Snapshot::*, bool local);
+
+		Napi::Value Create(const Napi::CallbackInfo&);
 		Napi::Value AddTrack(const Napi::CallbackInfo&);
 		Napi::Value AddTransceiver(const Napi::CallbackInfo&);
 		Napi::Value RemoveTrack(const Napi::CallbackInfo&);
@@ -143,9 +196,26 @@ namespace node_webrtc {
 		RTCSessionDescriptionInit _lastSdp;
 
 		UnsignedShortRange _port_range;
+		uint32_t _portAllocatorFlags = 0;
+		// The iceCandidatePoolSize asked for; CreateJinglePeerConnection raises it to at least 1 when it takes a warm
+		// port allocator (set on the signaling thread for RTCPeerConnection.create(), before the promise resolves).
+		int _iceCandidatePoolSize = 0;
+		bool _tookWarmPortAllocator = false;
 		ExtendedRTCConfiguration _cached_configuration;
+		webrtc::SdpSemantics _sdpSemantics = webrtc::SdpSemantics::kUnifiedPlan;
+		// Set by the constructor when RTCPeerConnection.create() defers creating _jinglePeerConnection to Create.
+		std::unique_ptr<webrtc::PeerConnectionInterface::RTCConfiguration> _pendingConfiguration;
 		rtc::scoped_refptr<webrtc::PeerConnectionInterface> _jinglePeerConnection;
 
+		// Guards _snapshot, and _jinglePeerConnection against being cleared while the signaling thread reads it.
+		std::mutex _snapshotMutex;
+		Snapshot _snapshot;
+
+		// Candidates gathered on the signaling thread and not yet delivered to JavaScript. OnIceCandidate only dispatches
+		// an event when this is empty, so candidates gathered in quick succession reach JavaScript in a single callback.
+		std::mutex _iceCandidatesMutex;
+		std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> _iceCandidates;
+
 		PeerConnectionFactory* _factory = nullptr;
 		bool _shouldReleaseFactory = false;
 
@@ -10,22 +10,38 @@
 #include "peer_connection_factory.h"
 
 #include <memory>
+#include <utility>
+
+#if defined(WEBRTC_POSIX)
+#include <time.h>
+#elif defined(WEBRTC_WIN)
+#include <windows.h>
+#endif
 
 #include <webrtc/api/audio_codecs/builtin_audio_decoder_factory.h>
 #include <webrtc/api/audio_codecs/builtin_audio_encoder_factory.h>
+#include <webrtc/api/call/call_factory_interface.h>
 #include <webrtc/api/create_peerconnection_factory.h>
 #include <webrtc/api/peer_connection_interface.h>
+#include <webrtc/api/rtc_event_log/rtc_event_log_factory.h>
+#include <webrtc/api/task_queue/default_task_queue_factory.h>
 #include <webrtc/api/video_codecs/builtin_video_decoder_factory.h>
 #include <webrtc/api/video_codecs/builtin_video_encoder_factory.h>
 #include <webrtc/api/video_codecs/video_decoder_factory.h>
 #include <webrtc/api/video_codecs/video_encoder_factory.h>
 #include <webrtc/modules/audio_device/include/audio_device.h>
+#include <webrtc/media/engine/webrtc_media_engine.h>
 #include <webrtc/modules/audio_device/include/fake_audio_device.h>
 #include <webrtc/p2p/base/basic_packet_socket_factory.h>
 #include <webrtc/rtc_base/location.h>
 #include <webrtc/rtc_base/ssl_adapter.h>
 #include <webrtc/rtc_base/thread.h>
 
+#include "src/converters.h"
+#include "src/converters/arguments.h"
+#include "src/webrtc/caching_network_manager.h"
+#include "src/webrtc/in_process_network.h"
+#include "src/webrtc/prebinding_packet_socket_factory.h"
 #include "src/webrtc/test_audio_device_module.h"
 #include "src/webrtc/zero_capturer.h"
 #include <iostream>
@@ -40,9 +56,10 @@ Napi::FunctionReference& PeerConnectionFactory::constructor() {
 PeerConnectionFactory* PeerConnectionFactory::_default = nullptr;
 std::mutex PeerConnectionFactory::_mutex{};  // NOLINT
 int PeerConnectionFactory::_references = 0;
+int PeerConnectionFactory::_audioSinks = 0;
 
 PeerConnectionFactory::PeerConnectionFactory(const Napi::CallbackInfo& info)
-  : Napi::ObjectWrap<PeerConnectionFactory>(info) {
+  : Napi::ObjectWrap<PeerConnectionFactory>(info), Counted<PeerConnectionFactory>("PeerConnectionFactory") {
   auto env = info.Env();
   bool result = false;
 
@@ -74,48 +91,139 @@ PeerConnectionFactory::PeerConnectionFactory(const Napi::CallbackInfo& info)
   result = _workerThread->Start();
   assert(result);
 
-  _audioDeviceModule = _workerThread->Invoke<rtc::scoped_refptr<webrtc::AudioDeviceModule>>(RTC_FROM_HERE, [audioLayer]() {
-    return audioLayer.Map([](auto audioLayer) {
-      // TODO(mroberts): I'm just trying to get this to compile right now.
-      // We need to call something like CreateDefaultzTaskQueueFactory().
-      // This code is currently unused, though.
-      return webrtc::AudioDeviceModule::Create(audioLayer, nullptr);
-    }).Or([]() {
-      return TestAudioDeviceModule::CreateTestAudioDeviceModule(
-              ZeroCapturer::Create(48000),
-              TestAudioDeviceModule::CreateDiscardRenderer(48000));
+  const auto& factoryOptions = DefaultOptions();
+
+  if (factoryOptions.dataOnly) {
+    // Without a media engine or call factory, PeerConnections never create a
+    // webrtc::Call, so there is no ADM, no codec factories and no audio
+    // processing thread.
+    webrtc::PeerConnectionFactoryDependencies dependencies;
+    dependencies.network_thread = _workerThread.get();
+    dependencies.worker_thread = _workerThread.get();
+    dependencies.signaling_thread = _signalingThread.get();
+    dependencies.task_queue_factory = webrtc::CreateDefaultTaskQueueFactory();
+    _factory = webrtc::CreateModularPeerConnectionFactory(std::move(dependencies));
+  } else {
+    _audioDeviceModule = _workerThread->Invoke<rtc::scoped_refptr<webrtc::AudioDeviceModule>>(RTC_FROM_HERE, [this, audioLayer]() {
+      return audioLayer.Map([](auto audioLayer) {
+        // TODO(mroberts): I'm just trying to get this to compile right now.
+        // We need to call something like CreateDefaultzTaskQueueFactory().
+        // This code is currently unused, though.
+        return webrtc::AudioDeviceModule::Create(audioLayer, nullptr);
+      }).Or([this]() {
+        auto audioDeviceModule = TestAudioDeviceModule::CreateTestAudioDeviceModule(
+                ZeroCapturer::Create(48000),
+                TestAudioDeviceModule::CreateDiscardRenderer(48000));
+        _testAudioDeviceModule = audioDeviceModule.get();
+        return rtc::scoped_refptr<webrtc::AudioDeviceModule>(audioDeviceModule);
+      });
     });
-  });
 
-  _factory = webrtc::CreatePeerConnectionFactory(
-          _workerThread.get(),
-          _workerThread.get(),
-          _signalingThread.get(),
-          _audioDeviceModule.get(),
-          webrtc::CreateBuiltinAudioEncoderFactory(),
-          webrtc::CreateBuiltinAudioDecoderFactory(),
-          webrtc::CreateBuiltinVideoEncoderFactory(),
-          webrtc::CreateBuiltinVideoDecoderFactory(),
-          nullptr,
-          nullptr);
+    _playoutOnlyForSinks = factoryOptions.playoutOnlyForSinks;
+    UpdatePlayout();
+
+    if (factoryOptions.audioProcessing) {
+      _factory = webrtc::CreatePeerConnectionFactory(
+              _workerThread.get(),
+              _workerThread.get(),
+              _signalingThread.get(),
+              _audioDeviceModule.get(),
+              webrtc::CreateBuiltinAudioEncoderFactory(),
+              webrtc::CreateBuiltinAudioDecoderFactory(),
+              webrtc::CreateBuiltinVideoEncoderFactory(),
+              webrtc::CreateBuiltinVideoDecoderFactory(),
+              nullptr,
+              nullptr);
+    } else {
+      // CreatePeerConnectionFactory substitutes a default AudioProcessing for
+      // nullptr, so assemble the media engine ourselves, without one.
+      webrtc::PeerConnectionFactoryDependencies dependencies;
+      dependencies.network_thread = _workerThread.get();
+      dependencies.worker_thread = _workerThread.get();
+      dependencies.signaling_thread = _signalingThread.get();
+      dependencies.task_queue_factory = webrtc::CreateDefaultTaskQueueFactory();
+      dependencies.call_factory = webrtc::CreateCallFactory();
+      dependencies.event_log_factory = std::unique_ptr<webrtc::RtcEventLogFactoryInterface>(
+              new webrtc::RtcEventLogFactory(dependencies.task_queue_factory.get()));
+
+      cricket::MediaEngineDependencies mediaDependencies;
+      mediaDependencies.task_queue_factory = dependencies.task_queue_factory.get();
+      mediaDependencies.adm = _audioDeviceModule;
+      mediaDependencies.audio_encoder_factory = webrtc::CreateBuiltinAudioEncoderFactory();
+      mediaDependencies.audio_decoder_factory = webrtc::CreateBuiltinAudioDecoderFactory();
+      mediaDependencies.video_encoder_factory = webrtc::CreateBuiltinVideoEncoderFactory();
+      mediaDependencies.video_decoder_factory = webrtc::CreateBuiltinVideoDecoderFactory();
+      dependencies.media_engine = cricket::CreateMediaEngine(std::move(mediaDependencies));
+
+      _factory = webrtc::CreateModularPeerConnectionFactory(std::move(dependencies));
+    }
+  }
   assert(_factory);
 
+  // Audio sources created through this factory start from these.
+  _audioOptions.echo_cancellation = factoryOptions.echoCancellation;
+  _audioOptions.noise_suppression = factoryOptions.noiseSuppression;
+  _audioOptions.auto_gain_control = factoryOptions.autoGainControl;
+  _audioOptions.highpass_filter = factoryOptions.highpassFilter;
+
   webrtc::PeerConnectionFactoryInterface::Options options;
   options.network_ignore_mask = 0;
   _factory->SetOptions(options);
 
-  _networkManager = std::unique_ptr<rtc::NetworkManager>(new rtc::BasicNetworkManager());
+  // Every RTCPeerConnection's BasicPortAllocator shares these.
+  if (factoryOptions.inProcessNetwork) {
+    _networkManager = std::unique_ptr<rtc::NetworkManager>(new InProcessNetworkManager());
+  } else if (factoryOptions.networks.empty() && !factoryOptions.cacheNetworks) {
+    _networkManager = std::unique_ptr<rtc::NetworkManager>(new rtc::BasicNetworkManager());
+  } else {
+    _networkManager = std::unique_ptr<rtc::NetworkManager>(new CachingNetworkManager(
+            factoryOptions.networks,
+            factoryOptions.cacheNetworks));
+  }
   assert(_networkManager != nullptr);
 
-  _socketFactory = std::unique_ptr<rtc::PacketSocketFactory>(new rtc::BasicPacketSocketFactory(_workerThread.get()));
+  if (factoryOptions.inProcessNetwork) {
+    _socketFactory = std::unique_ptr<rtc::PacketSocketFactory>(new InProcessPacketSocketFactory(
+            _workerThread.get(),
+            factoryOptions.networkConditions));
+    // The in-process network only carries UDP.
+    _portAllocatorFlags = cricket::PORTALLOCATOR_DISABLE_TCP;
+  } else {
+    _socketFactory = std::unique_ptr<rtc::PacketSocketFactory>(new PrebindingPacketSocketFactory(
+            _workerThread.get(),
+            factoryOptions.prebindSockets,
+            factoryOptions.batchUdp,
+            factoryOptions.udpReceiveBufferSize,
+            factoryOptions.udpSendBufferSize));
+  }
   assert(_socketFactory != nullptr);
+
+  if (factoryOptions.iceCandidatePoolSize) {
+    _portAllocatorPool = _workerThread->Invoke<std::unique_ptr<PortAllocatorPool>>(RTC_FROM_HERE, [this, &factoryOptions]() {
+      return std::unique_ptr<PortAllocatorPool>(new PortAllocatorPool(
+              _workerThread.get(),
+              _networkManager.get(),
+              _socketFactory.get(),
+              factoryOptions.iceCandidatePoolSize,
+              factoryOptions.iceCandidatePoolServers,
+              factoryOptions.iceCandidatePoolPortRange,
+              _portAllocatorFlags));
+    });
+  }
 }
 
 PeerConnectionFactory::~PeerConnectionFactory() {
   _factory = nullptr;
 
   _workerThread->Invoke<void>(RTC_FROM_HERE, [this]() {
+    this->_testAudioDeviceModule = nullptr;
     this->_audioDeviceModule = nullptr;
+    // Warm allocators use the network manager and socket factory.
+    this->_portAllocatorPool = nullptr;
+    // Sockets, including prebound ones, must be closed on the thread whose
+    // SocketServer created them.
+    this->_networkManager = nullptr;
+    this->_socketFactory = nullptr;
   });
 
   _workerThread->Stop();
@@ -124,8 +232,6 @@ PeerConnectionFactory::~PeerConnectionFactory() {
   _workerThread = nullptr;
   _signalingThread = nullptr;
 
-  _networkManager = nullptr;
-  _socketFactory = nullptr;
 }
 
 PeerConnectionFactory* PeerConnectionFactory::GetOrCreateDefault() {
@@ -156,6 +262,111 @@ void PeerConnectionFactory::Release() {
   _mutex.unlock();
 }
 
+void PeerConnectionFactory::AddAudioSink() {
+  _mutex.lock();
+  if (_audioSinks++ == 0 && _default) {
+    _default->UpdatePlayout();
+  }
+  _mutex.unlock();
+}
+
+void PeerConnectionFactory::RemoveAudioSink() {
+  _mutex.lock();
+  if (--_audioSinks == 0 && _default) {
+    _default->UpdatePlayout();
+  }
+  _mutex.unlock();
+}
+
+void PeerConnectionFactory::UpdatePlayout() {
+  if (_playoutOnlyForSinks && _testAudioDeviceModule) {
+    _testAudioDeviceModule->SetPlayoutPaused(_audioSinks == 0);
+  }
+}
+
+/**
+ * Get the CPU time, in milliseconds, consumed so far by the calling thread, or
+ * a negative number if the platform cannot report it.
+ */
+static double GetCurrentThreadCpuTime() {
+#if defined(WEBRTC_POSIX)
+  struct timespec time = {};
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+    return -1;
+  }
+  return time.tv_sec * 1e3 + time.tv_nsec / 1e6;
+#elif defined(WEBRTC_WIN)
+  FILETIME creation, exit, kernel, user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+    return -1;
+  }
+  ULARGE_INTEGER kernelTime = { { kernel.dwLowDateTime, kernel.dwHighDateTime } };
+  ULARGE_INTEGER userTime = { { user.dwLowDateTime, user.dwHighDateTime } };
+  return (kernelTime.QuadPart + userTime.QuadPart) / 1e4;  // 100 ns units
+#else
+  return -1;
+#endif
+}
+
+std::map<std::string, double> PeerConnectionFactory::GetDefaultThreadCpuTimes() {
+  std::map<std::string, double> times;
+  // Hold a reference rather than the mutex across the Invokes: the signaling and
+  // worker threads take the mutex themselves (e.g., Release, RemoveAudioSink).
+  _mutex.lock();
+  auto factory = _default;
+  if (factory) {
+    _references++;
+  }
+  _mutex.unlock();
+  if (!factory) {
+    return times;
+  }
+  auto signaling = factory->_signalingThread->Invoke<double>(RTC_FROM_HERE, GetCurrentThreadCpuTime);
+  auto worker = factory->_workerThread->Invoke<double>(RTC_FROM_HERE, GetCurrentThreadCpuTime);
+  if (signaling >= 0 && worker >= 0) {
+    times["signaling"] = signaling;
+    times["worker"] = worker;
+  }
+  Release();
+  return times;
+}
+
+std::unique_ptr<cricket::PortAllocator> PeerConnectionFactory::TakeWarmPortAllocator(
+    const webrtc::PeerConnectionInterface::RTCConfiguration& configuration,
+    const UnsignedShortRange& portRange,
+    uint32_t portAllocatorFlags) {
+  return _portAllocatorPool
+      ? _portAllocatorPool->Take(configuration, portRange, portAllocatorFlags)
+      : nullptr;
+}
+
+PeerConnectionFactoryOptions& PeerConnectionFactory::DefaultOptions() {
+  static auto options = new PeerConnectionFactoryOptions();
+  return *options;
+}
+
+Napi::Value PeerConnectionFactory::SetPeerConnectionFactoryOptions(const Napi::CallbackInfo& info) {
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, options, PeerConnectionFactoryOptions)
+  DefaultOptions() = options;
+  return info.Env().Undefined();
+}
+
+Napi::Value PeerConnectionFactory::GetIceCandidatePoolStats(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  PortAllocatorPool::Stats stats = {0, 0, 0, 0};
+  _mutex.lock();
+  if (_default && _default->_portAllocatorPool) {
+    stats = _default->_portAllocatorPool->stats();
+  }
+  _mutex.unlock();
+  auto object = Napi::Object::New(env);
+  object.Set("size", Napi::Number::New(env, static_cast<double>(stats.size)));
+  object.Set("available", Napi::Number::New(env, static_cast<double>(stats.available)));
+  object.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+  object.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+  return object;
+}
+
 void PeerConnectionFactory::Dispose() {
   rtc::CleanupSSL();
 }
@@ -173,6 +384,8 @@ void PeerConnectionFactory::Init(Napi::Env env, Napi::Object exports) {
   constructor().SuppressDestruct();
 
   exports.Set("RTCPeerConnectionFactory", func);
+  exports.Set("setPeerConnectionFactoryOptions", Napi::Function::New(env, SetPeerConnectionFactoryOptions));
+  exports.Set("getIceCandidatePoolStats", Napi::Function::New(env, GetIceCandidatePoolStats));
 }
 
 }  // namespace node_webrtc
@@ -9,15 +9,21 @@
  */
 #pragma once
 
+#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 
 #include <node-addon-api/napi.h>
+#include <webrtc/api/audio_options.h>
 #include <webrtc/api/peer_connection_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/modules/audio_device/include/audio_device.h>
 
+#include "src/dictionaries/node_webrtc/peer_connection_factory_options.h"
 #include "src/functional/maybe.h"
+#include "src/node/object_census.h"
+#include "src/webrtc/port_allocator_pool.h"
 
 namespace rtc {
 
@@ -35,8 +41,11 @@ class PeerConnectionFactoryInterface;
 
 namespace node_webrtc {
 
+class TestAudioDeviceModule;
+
 class PeerConnectionFactory
-  : public Napi::ObjectWrap<PeerConnectionFactory> {
+  : public Napi::ObjectWrap<PeerConnectionFactory>
+  , public Counted<PeerConnectionFactory> {
  public:
   explicit PeerConnectionFactory(const Napi::CallbackInfo&);
 
@@ -53,6 +62,15 @@ class PeerConnectionFactory
    */
   static void Release();
 
+  /**
+   * Get the CPU time, in milliseconds, consumed so far by each of the default
+   * PeerConnectionFactory's threads, keyed by thread role ("signaling",
+   * "worker"). Returns an empty map if there is no default
+   * PeerConnectionFactory, or if the platform cannot report per-thread CPU
+   * time.
+   */
+  static std::map<std::string, double> GetDefaultThreadCpuTimes();
+
   /**
    * Get the underlying webrtc::PeerConnectionFactoryInterface.
    */
@@ -62,6 +80,43 @@ class PeerConnectionFactory
 
   rtc::PacketSocketFactory* getSocketFactory() { return _socketFactory.get(); }
 
+  /**
+   * Get the cricket::AudioOptions that audio sources created through this
+   * factory start from, as set by PeerConnectionFactoryOptions.
+   */
+  const cricket::AudioOptions& audioOptions() const { return _audioOptions; }
+
+  /**
+   * Get the cricket::PortAllocator flags that every RTCPeerConnection using
+   * this factory must add to its own.
+   */
+  uint32_t portAllocatorFlags() const { return _portAllocatorFlags; }
+
+  /**
+   * Take a warm cricket::PortAllocator from the factory's PortAllocatorPool.
+   * @return an allocator, or nullptr if the factory has no pool or none of
+   * its allocators suit the configuration
+   */
+  std::unique_ptr<cricket::PortAllocator> TakeWarmPortAllocator(
+      const webrtc::PeerConnectionInterface::RTCConfiguration& configuration,
+      const UnsignedShortRange& portRange,
+      uint32_t portAllocatorFlags);
+
+  /**
+   * RTCAudioSinks call these when they start and stop, so that a default
+   * PeerConnectionFactory created with playoutOnlyForSinks only plays out
+   * (and so decodes) remote audio while at least one is attached. Must be
+   * called on the main thread.
+   */
+  static void AddAudioSink();
+  static void RemoveAudioSink();
+
+  /**
+   * Get the PeerConnectionFactoryOptions that the next default
+   * PeerConnectionFactory will be created with.
+   */
+  static PeerConnectionFactoryOptions& DefaultOptions();
+
   static void Init(Napi::Env, Napi::Object);
 
   static Napi::FunctionReference& constructor();
@@ -72,15 +127,27 @@ class PeerConnectionFactory
   std::unique_ptr<rtc::Thread> _workerThread;
 
  private:
+  static Napi::Value SetPeerConnectionFactoryOptions(const Napi::CallbackInfo&);
+  static Napi::Value GetIceCandidatePoolStats(const Napi::CallbackInfo&);
+
+  void UpdatePlayout();
+
   static PeerConnectionFactory* _default;
   static std::mutex _mutex;
   static int _references;
+  static int _audioSinks;
 
   rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> _factory;
   rtc::scoped_refptr<webrtc::AudioDeviceModule> _audioDeviceModule;
+  // The same as _audioDeviceModule, unless that is a platform ADM.
+  TestAudioDeviceModule* _testAudioDeviceModule = nullptr;
+  bool _playoutOnlyForSinks = false;
+  cricket::AudioOptions _audioOptions;
 
   std::unique_ptr<rtc::NetworkManager> _networkManager;
   std::unique_ptr<rtc::PacketSocketFactory> _socketFactory;
+  std::unique_ptr<PortAllocatorPool> _portAllocatorPool;
+  uint32_t _portAllocatorFlags = 0;
 };
 
 }  // namespace node_webrtc
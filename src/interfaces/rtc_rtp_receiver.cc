@@ -36,7 +36,7 @@ namespace node_webrtc {
 	}
 
 	RTCRtpReceiver::RTCRtpReceiver(const Napi::CallbackInfo& info) :
-		Napi::ObjectWrap<RTCRtpReceiver>(info)
+		Napi::ObjectWrap<RTCRtpReceiver>(info), Counted<RTCRtpReceiver>("RTCRtpReceiver")
 	{
 		if (info.Length() != 2 || !info[0].IsExternal() || !info[1].IsExternal()) {
 			Napi::TypeError::New(info.Env(), "You cannot construct a RTCRtpReceiver").ThrowAsJavaScriptException();
@@ -16,6 +16,7 @@
 
 #include "src/converters/napi.h"
 #include "src/node/async_object_wrap.h"
+#include "src/node/object_census.h"
 #include "src/node/wrap.h"
 #include "src/interfaces/media_stream_track.h"
 #include "src/interfaces/media_stream.h"
@@ -29,7 +30,7 @@ namespace node_webrtc {
 	class RTCRtpTransceiver;
 	class RTCPeerConnection;
 
-	class RTCRtpReceiver : public Napi::ObjectWrap<RTCRtpReceiver> {
+	class RTCRtpReceiver : public Napi::ObjectWrap<RTCRtpReceiver>, public Counted<RTCRtpReceiver> {
 	public:
 		explicit RTCRtpReceiver(const Napi::CallbackInfo&);
 		static void Init(Napi::Env, Napi::Object);
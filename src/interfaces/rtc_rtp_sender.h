@@ -17,6 +17,7 @@
 #include "src/utilities/napi_ref_ptr.h"
 #include "src/converters/napi.h"
 #include "src/node/async_object_wrap.h"
+#include "src/node/object_census.h"
 #include "src/node/wrap.h"
 #include "src/interfaces/media_stream_track.h"
 #include "src/interfaces/rtc_peer_connection.h"
@@ -31,7 +32,7 @@ namespace node_webrtc {
 	class RTCPeerConnection;
 	class RTCRtpTransceiver;
 
-	class RTCRtpSender : public Napi::ObjectWrap<RTCRtpSender> {
+	class RTCRtpSender : public Napi::ObjectWrap<RTCRtpSender>, public Counted<RTCRtpSender> {
 	public:
 		explicit RTCRtpSender(const Napi::CallbackInfo&);
 		static void Init(Napi::Env, Napi::Object);
@@ -37,7 +37,7 @@ namespace node_webrtc {
 	}
 
 	RTCRtpTransceiver::RTCRtpTransceiver(const Napi::CallbackInfo& info) :
-		Napi::ObjectWrap<RTCRtpTransceiver>(info)
+		Napi::ObjectWrap<RTCRtpTransceiver>(info), Counted<RTCRtpTransceiver>("RTCRtpTransceiver")
 	{
 		if (info.Length() != 3 || !info[0].IsExternal() || !info[1].IsExternal() || !info[2].IsExternal()) {
 			Napi::TypeError::New(info.Env(), "You cannot construct a RTCRtpTransceiver").ThrowAsJavaScriptException();
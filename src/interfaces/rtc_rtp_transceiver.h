@@ -18,6 +18,7 @@
 #include "src/converters/napi.h"
 #include "src/converters/napi.h"
 #include "src/node/async_object_wrap.h"
+#include "src/node/object_census.h"
 #include "src/node/wrap.h"
 #include "src/interfaces/rtc_peer_connection.h"
 
@@ -27,7 +28,7 @@ namespace node_webrtc {
 	class RTCPeerConnection;
 	class RTCRtpSender;
 	class RTCRtpReceiver;
-	class RTCRtpTransceiver : public Napi::ObjectWrap<RTCRtpTransceiver> {
+	class RTCRtpTransceiver : public Napi::ObjectWrap<RTCRtpTransceiver>, public Counted<RTCRtpTransceiver> {
 	public:
 		explicit RTCRtpTransceiver(const Napi::CallbackInfo&);
 		static void Init(Napi::Env, Napi::Object);
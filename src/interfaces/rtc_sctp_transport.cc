@@ -14,6 +14,7 @@
 #include "src/enums/webrtc/sctp_transport_state.h"
 #include "src/interfaces/rtc_dtls_transport.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
@@ -95,7 +96,7 @@ void RTCSctpTransport::OnStateChange(const webrtc::SctpTransportInformation info
     auto env = Env();
     Napi::HandleScope scope(env);
     auto event = Napi::Object::New(env);
-    event.Set("type", Napi::String::New(env, "statechange"));
+    event.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "statechange"));
     MakeCallback("dispatchEvent", { event });
   }));
 
@@ -125,6 +126,7 @@ Napi::Value RTCSctpTransport::GetMaxChannels(const Napi::CallbackInfo& info) {
 
 void RTCSctpTransport::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(env, "RTCSctpTransport", {
+    InstanceMethod("getQueueMetrics", &RTCSctpTransport::GetQueueMetrics),
     InstanceAccessor("transport", &RTCSctpTransport::GetTransport, nullptr),
     InstanceAccessor("state", &RTCSctpTransport::GetState, nullptr),
     InstanceAccessor("maxMessageSize", &RTCSctpTransport::GetMaxMessageSize, nullptr),
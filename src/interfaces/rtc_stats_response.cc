@@ -22,7 +22,7 @@ Napi::FunctionReference& RTCStatsResponse::constructor() {
   return constructor;
 }
 
-RTCStatsResponse::RTCStatsResponse(const Napi::CallbackInfo& info): Napi::ObjectWrap<RTCStatsResponse>(info) {
+RTCStatsResponse::RTCStatsResponse(const Napi::CallbackInfo& info): Napi::ObjectWrap<RTCStatsResponse>(info), Counted<RTCStatsResponse>("RTCStatsResponse") {
   auto env = info.Env();
   Napi::HandleScope scope(env);
 
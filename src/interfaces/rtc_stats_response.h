@@ -15,10 +15,13 @@
 #include <string>
 #include <vector>
 
+#include "src/node/object_census.h"
+
 namespace node_webrtc {
 
 class RTCStatsResponse
-  : public Napi::ObjectWrap<RTCStatsResponse> {
+  : public Napi::ObjectWrap<RTCStatsResponse>
+  , public Counted<RTCStatsResponse> {
  public:
   explicit RTCStatsResponse(const Napi::CallbackInfo&);
 
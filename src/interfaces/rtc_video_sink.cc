@@ -9,6 +9,7 @@
  */
 #include "src/interfaces/rtc_video_sink.h"
 
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -17,10 +18,13 @@
 #include "src/converters.h"
 #include "src/converters/arguments.h"
 #include "src/converters/napi.h"
+#include "src/dictionaries/node_webrtc/rtc_video_sink_init.h"
 #include "src/dictionaries/webrtc/video_frame.h"  // IWYU pragma: keep
+#include "src/functional/maybe.h"
 #include "src/functional/validation.h"
 #include "src/interfaces/media_stream_track.h"  // IWYU pragma: keep
 #include "src/node/events.h"
+#include "src/node/interned_strings.h"
 
 namespace node_webrtc {
 
@@ -35,7 +39,11 @@ RTCVideoSink::RTCVideoSink(const Napi::CallbackInfo& info)
     Napi::TypeError::New(info.Env(), "Use the new operator to construct an RTCVideoSink.").ThrowAsJavaScriptException();
     return;
   }
-  CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(info, track, rtc::scoped_refptr<webrtc::VideoTrackInterface>)
+  CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(info, args, std::tuple<rtc::scoped_refptr<webrtc::VideoTrackInterface> COMMA Maybe<RTCVideoSinkInit>>)
+
+  auto track = std::get<0>(args);
+  auto init = std::get<1>(args);
+  _coalesceFrames = init.IsJust() && init.UnsafeFromJust().coalesceFrames;
 
   _track = std::move(track);
 
@@ -63,7 +71,7 @@ Napi::Value RTCVideoSink::JsStop(const Napi::CallbackInfo& info) {
 }
 
 void RTCVideoSink::OnFrame(const webrtc::VideoFrame& frame) {
-  Dispatch(CreateCallback<RTCVideoSink>([this, frame]() {
+  auto event = CreateCallback<RTCVideoSink>([this, frame]() {
     auto env = Env();
     Napi::HandleScope scope(env);
     auto maybeValue = From<Napi::Value>(std::make_pair(env, frame));
@@ -72,14 +80,20 @@ void RTCVideoSink::OnFrame(const webrtc::VideoFrame& frame) {
       return;
     }
     auto object = Napi::Object::New(env);
-    object.Set("type", Napi::String::New(env, "frame"));
-    object.Set("frame", maybeValue.UnsafeFromValid());
+    object.Set(InternedStrings::Get(env, "type"), InternedStrings::Get(env, "frame"));
+    object.Set(InternedStrings::Get(env, "frame"), maybeValue.UnsafeFromValid());
     MakeCallback("dispatchEvent", { object });
-  }));
+  });
+  if (_coalesceFrames) {
+    DispatchCoalesced(std::move(event));
+  } else {
+    Dispatch(std::move(event), EventLane::kMedia);
+  }
 }
 
 void RTCVideoSink::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(env, "RTCVideoSink", {
+    InstanceMethod("getQueueMetrics", &RTCVideoSink::GetQueueMetrics),
     InstanceAccessor("stopped", &RTCVideoSink::GetStopped, nullptr),
     InstanceMethod("stop", &RTCVideoSink::JsStop)
   });
@@ -40,6 +40,7 @@ class RTCVideoSink
 
   Napi::Value JsStop(const Napi::CallbackInfo&);
 
+  bool _coalesceFrames = false;
   bool _stopped = false;
   rtc::scoped_refptr<webrtc::VideoTrackInterface> _track;
 };
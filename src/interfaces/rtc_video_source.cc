@@ -13,6 +13,7 @@
 #include <webrtc/api/video/i420_buffer.h>
 #include <webrtc/api/video/video_frame.h>
 #include <webrtc/rtc_base/ref_counted_object.h>
+#include <webrtc/rtc_base/trace_event.h>
 
 #include "src/converters.h"
 #include "src/converters/absl.h"
@@ -33,7 +34,7 @@ Napi::FunctionReference& RTCVideoSource::constructor() {
 }
 
 RTCVideoSource::RTCVideoSource(const Napi::CallbackInfo& info)
-  : Napi::ObjectWrap<RTCVideoSource>(info) {
+  : Napi::ObjectWrap<RTCVideoSource>(info), Counted<RTCVideoSource>("RTCVideoSource") {
   New(info);
 }
 
@@ -83,6 +84,7 @@ Napi::Value RTCVideoSource::CreateTrack(const Napi::CallbackInfo&) {
 }
 
 Napi::Value RTCVideoSource::OnFrame(const Napi::CallbackInfo& info) {
+  TRACE_EVENT0("node_webrtc", "RTCVideoSource::OnFrame");
   CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, buffer, rtc::scoped_refptr<webrtc::I420Buffer>)
 
   auto now = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now());
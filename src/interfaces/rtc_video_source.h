@@ -20,6 +20,7 @@
 #include "src/dictionaries/node_webrtc/rtc_video_source_init.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
 #include "src/interfaces/media_stream_track.h"
+#include "src/node/object_census.h"
 
 namespace webrtc { class VideoFrame; }
 
@@ -65,7 +66,8 @@ class RTCVideoTrackSource : public rtc::AdaptedVideoTrackSource {
 };
 
 class RTCVideoSource
-  : public Napi::ObjectWrap<RTCVideoSource> {
+  : public Napi::ObjectWrap<RTCVideoSource>
+  , public Counted<RTCVideoSource> {
  public:
   explicit RTCVideoSource(const Napi::CallbackInfo&);
   static void Init(Napi::Env, Napi::Object);
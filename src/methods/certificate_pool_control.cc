@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/methods/certificate_pool_control.h"
+
+#include <cstdint>
+
+#include "src/converters.h"
+#include "src/converters/arguments.h"
+#include "src/converters/napi.h"
+#include "src/webrtc/certificate_pool.h"
+
+namespace node_webrtc {
+
+Napi::Value CertificatePoolControl::SetCertificatePoolSize(const Napi::CallbackInfo& info) {
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, size, uint32_t)
+  CertificatePool::Get()->SetSize(size);
+  return info.Env().Undefined();
+}
+
+Napi::Value CertificatePoolControl::GetCertificatePoolStats(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  auto stats = CertificatePool::Get()->stats();
+  auto object = Napi::Object::New(env);
+  object.Set("size", Napi::Number::New(env, static_cast<double>(stats.size)));
+  object.Set("available", Napi::Number::New(env, static_cast<double>(stats.available)));
+  object.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+  object.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+  return object;
+}
+
+void CertificatePoolControl::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("setCertificatePoolSize", Napi::Function::New(env, SetCertificatePoolSize));
+  exports.Set("getCertificatePoolStats", Napi::Function::New(env, GetCertificatePoolStats));
+}
+
+}  // namespace node_webrtc
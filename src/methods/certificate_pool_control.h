@@ -0,0 +1,31 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * CertificatePoolControl exposes the CertificatePool:
+ * `setCertificatePoolSize(size)` sets how many certificates to keep ready for
+ * new RTCPeerConnections, and `getCertificatePoolStats()` reports how often
+ * one was ready.
+ */
+class CertificatePoolControl {
+ public:
+  static void Init(Napi::Env, Napi::Object);
+
+ private:
+  static Napi::Value SetCertificatePoolSize(const Napi::CallbackInfo&);
+  static Napi::Value GetCertificatePoolStats(const Napi::CallbackInfo&);
+};
+
+}  // namespace node_webrtc
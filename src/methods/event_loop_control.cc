@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/methods/event_loop_control.h"
+
+#include <cstdint>
+
+#include "src/converters.h"
+#include "src/converters/arguments.h"
+#include "src/converters/napi.h"
+#include "src/dictionaries/node_webrtc/event_loop_budget.h"
+#include "src/node/event_dispatcher.h"
+#include "src/node/event_queue_metrics.h"
+
+namespace node_webrtc {
+
+Napi::Value EventLoopControl::SetEventLoopBudget(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, budget, EventLoopBudget)
+  auto dispatcher = EventDispatcher::For(env);
+  if (!dispatcher) {
+    return env.Undefined();
+  }
+  dispatcher->SetBudget(static_cast<uint64_t>(budget.maxTime * 1e6), budget.maxEvents);
+  return env.Undefined();
+}
+
+Napi::Value EventLoopControl::GetEventLoopStats(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  auto dispatcher = EventDispatcher::For(env);
+  if (!dispatcher) {
+    return env.Undefined();
+  }
+  auto stats = Napi::Object::New(env);
+  stats.Set("wakeups", static_cast<double>(dispatcher->wakeups()));
+  stats.Set("yields", static_cast<double>(dispatcher->yields()));
+  return stats;
+}
+
+Napi::Value EventLoopControl::GetQueueMetrics(const Napi::CallbackInfo& info) {
+  return EventQueueMetrics::Aggregate().ToNapi(info.Env());
+}
+
+void EventLoopControl::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("setEventLoopBudget", Napi::Function::New(env, SetEventLoopBudget));
+  exports.Set("getEventLoopStats", Napi::Function::New(env, GetEventLoopStats));
+  exports.Set("getQueueMetrics", Napi::Function::New(env, GetQueueMetrics));
+}
+
+}  // namespace node_webrtc
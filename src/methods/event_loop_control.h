@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * EventLoopControl exposes the EventDispatcher that delivers native events to
+ * JavaScript: `setEventLoopBudget(budget)` bounds how long each wake-up may
+ * block the Node loop, and `getEventLoopStats()` reports how often it woke up
+ * and how often it yielded. `getQueueMetrics()` reports the process-wide
+ * aggregate of every object's EventQueueMetrics.
+ */
+class EventLoopControl {
+ public:
+  static void Init(Napi::Env, Napi::Object);
+
+ private:
+  static Napi::Value SetEventLoopBudget(const Napi::CallbackInfo&);
+  static Napi::Value GetEventLoopStats(const Napi::CallbackInfo&);
+  static Napi::Value GetQueueMetrics(const Napi::CallbackInfo&);
+};
+
+}  // namespace node_webrtc
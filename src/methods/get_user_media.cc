@@ -32,12 +32,18 @@
 struct MediaTrackConstraintSet {
   node_webrtc::Maybe<uint16_t> width;
   node_webrtc::Maybe<uint16_t> height;
+  node_webrtc::Maybe<bool> echoCancellation;
+  node_webrtc::Maybe<bool> noiseSuppression;
+  node_webrtc::Maybe<bool> autoGainControl;
 
   static MediaTrackConstraintSet Create(
       const node_webrtc::Maybe<uint16_t> width,
-      const node_webrtc::Maybe<uint16_t> height
+      const node_webrtc::Maybe<uint16_t> height,
+      const node_webrtc::Maybe<bool> echoCancellation,
+      const node_webrtc::Maybe<bool> noiseSuppression,
+      const node_webrtc::Maybe<bool> autoGainControl
   ) {
-    return {width, height};
+    return {width, height, echoCancellation, noiseSuppression, autoGainControl};
   }
 };
 
@@ -47,7 +53,10 @@ struct node_webrtc::Converter<Napi::Value, MediaTrackConstraintSet> {
     return node_webrtc::From<Napi::Object>(value).FlatMap<MediaTrackConstraintSet>([](auto object) {
       return curry(MediaTrackConstraintSet::Create)
           % node_webrtc::GetOptional<uint16_t>(object, "width")
-          * node_webrtc::GetOptional<uint16_t>(object, "height");
+          * node_webrtc::GetOptional<uint16_t>(object, "height")
+          * node_webrtc::GetOptional<bool>(object, "echoCancellation")
+          * node_webrtc::GetOptional<bool>(object, "noiseSuppression")
+          * node_webrtc::GetOptional<bool>(object, "autoGainControl");
     });
   }
 };
@@ -62,6 +71,9 @@ struct MediaTrackConstraints: public MediaTrackConstraintSet {
     MediaTrackConstraints constraints;
     constraints.width = set.width;
     constraints.height = set.height;
+    constraints.echoCancellation = set.echoCancellation;
+    constraints.noiseSuppression = set.noiseSuppression;
+    constraints.autoGainControl = set.autoGainControl;
     constraints.advanced = advanced;
     return constraints;
   }
@@ -121,7 +133,21 @@ Napi::Value node_webrtc::GetUserMedia::GetUserMediaImpl(const Napi::CallbackInfo
   }).FromMaybe(false);
 
   if (audio) {
-    cricket::AudioOptions options;
+    // Constraints override the factory's audio processing defaults.
+    auto options = factory->audioOptions();
+    auto audioConstraints = constraints.audio.UnsafeFromJust();
+    if (audioConstraints.IsRight()) {
+      auto trackConstraints = audioConstraints.UnsafeFromRight();
+      if (trackConstraints.echoCancellation.IsJust()) {
+        options.echo_cancellation = trackConstraints.echoCancellation.UnsafeFromJust();
+      }
+      if (trackConstraints.noiseSuppression.IsJust()) {
+        options.noise_suppression = trackConstraints.noiseSuppression.UnsafeFromJust();
+      }
+      if (trackConstraints.autoGainControl.IsJust()) {
+        options.auto_gain_control = trackConstraints.autoGainControl.UnsafeFromJust();
+      }
+    }
     auto source = factory->factory()->CreateAudioSource(options);
     auto track = factory->factory()->CreateAudioTrack(rtc::CreateRandomUuid(), source);
     stream->AddTrack(track);
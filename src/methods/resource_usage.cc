@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/methods/resource_usage.h"
+
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(WEBRTC_MAC)
+#include <malloc/malloc.h>
+#endif
+
+#include "src/converters.h"
+#include "src/converters/napi.h"
+#include "src/functional/maybe.h"
+#include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
+#include "src/node/external_memory.h"
+#include "src/node/object_census.h"
+
+namespace node_webrtc {
+
+static Maybe<double> GetNativeHeapBytes() {
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+  auto info = mallinfo2();
+  return MakeJust(static_cast<double>(info.uordblks + info.hblkhd));
+#elif defined(__GLIBC__)
+  // NOTE: mallinfo's fields are ints, so this wraps past 2 GiB.
+  auto info = mallinfo();
+  return MakeJust(static_cast<double>(static_cast<unsigned>(info.uordblks) + static_cast<unsigned>(info.hblkhd)));
+#elif defined(WEBRTC_MAC)
+  malloc_statistics_t stats;
+  malloc_zone_statistics(nullptr, &stats);
+  return MakeJust(static_cast<double>(stats.size_in_use));
+#else
+  return MakeNothing<double>();
+#endif
+}
+
+Napi::Value ResourceUsage::GetResourceUsage(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  auto object = Napi::Object::New(env);
+
+  CONVERT_OR_THROW_AND_RETURN_NAPI(env, GetNativeHeapBytes(), nativeHeap, Napi::Value)
+  object.Set("nativeHeap", nativeHeap);
+
+  auto threads = PeerConnectionFactory::GetDefaultThreadCpuTimes();
+  if (threads.empty()) {
+    object.Set("threads", env.Null());
+  } else {
+    auto threadsObject = Napi::Object::New(env);
+    for (const auto& thread : threads) {
+      threadsObject.Set(thread.first, thread.second);
+    }
+    object.Set("threads", threadsObject);
+  }
+
+  object.Set("external", ExternalMemory::ToNapi(env));
+
+  return object;
+}
+
+Napi::Value ResourceUsage::GetNativeObjectCounts(const Napi::CallbackInfo& info) {
+  return ObjectCensus::ToNapi(info.Env());
+}
+
+void ResourceUsage::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("getResourceUsage", Napi::Function::New(env, GetResourceUsage));
+  exports.Set("getNativeObjectCounts", Napi::Function::New(env, GetNativeObjectCounts));
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,36 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * ResourceUsage exposes `getResourceUsage()`, which reports resource usage
+ * that Node's own process APIs cannot see: the size of the native (malloc)
+ * heap, the CPU time consumed by the default PeerConnectionFactory's
+ * threads, and the native bytes held by ArrayBuffers we have handed out (see
+ * ExternalMemory).
+ *
+ * It also exposes `getNativeObjectCounts()`, which reports the ObjectCensus:
+ * how many of each wrapped object are alive, still running and waiting on
+ * events, along with the ExternalMemory totals. It is cheap enough to poll.
+ */
+class ResourceUsage {
+ public:
+  static void Init(Napi::Env, Napi::Object);
+
+ private:
+  static Napi::Value GetResourceUsage(const Napi::CallbackInfo&);
+  static Napi::Value GetNativeObjectCounts(const Napi::CallbackInfo&);
+};
+
+}  // namespace node_webrtc
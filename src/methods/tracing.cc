@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/methods/tracing.h"
+
+#include <cstdlib>
+#include <mutex>
+
+#include "src/converters.h"
+#include "src/converters/arguments.h"
+#include "src/converters/napi.h"
+#include "src/webrtc/event_tracer.h"
+
+namespace node_webrtc {
+
+// The env that started the current capture, which stops it on teardown. Only
+// that env may stop it: its cleanup hook can only be removed on its thread.
+static std::mutex ownerMutex;
+static napi_env owner = nullptr;
+
+bool Tracing::Start(Napi::Env env, const std::string& path) {
+  std::lock_guard<std::mutex> lock(ownerMutex);
+  if (!EventTracer::Start(path)) {
+    return false;
+  }
+  owner = env;
+  napi_add_env_cleanup_hook(env, Stop, static_cast<napi_env>(env));
+  return true;
+}
+
+void Tracing::Stop(void* arg) {
+  std::lock_guard<std::mutex> lock(ownerMutex);
+  if (owner == static_cast<napi_env>(arg)) {
+    EventTracer::Stop();
+    owner = nullptr;
+  }
+}
+
+Napi::Value Tracing::StartTracing(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, path, std::string)
+  if (!Start(env, path)) {
+    auto message = EventTracer::IsTracing()
+        ? "Already tracing"
+        : "Unable to open \"" + path + "\" for writing";
+    Napi::Error::New(env, message).ThrowAsJavaScriptException();
+  }
+  return env.Undefined();
+}
+
+Napi::Value Tracing::StopTracing(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  ownerMutex.lock();
+  auto current = owner;
+  ownerMutex.unlock();
+  if (!current) {
+    return env.Undefined();
+  }
+  // Only this env's Stop clears owner, so it cannot change underneath us.
+  if (current != static_cast<napi_env>(env)) {
+    Napi::Error::New(env, "Tracing was started by another thread, which must stop it").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  napi_remove_env_cleanup_hook(env, Stop, static_cast<napi_env>(env));
+  Stop(static_cast<napi_env>(env));
+  return env.Undefined();
+}
+
+void Tracing::Init(Napi::Env env, Napi::Object exports) {
+  EventTracer::Install();
+
+  auto path = std::getenv("NODE_WEBRTC_TRACE_FILE");
+  if (path && *path && !EventTracer::IsTracing()) {
+    Start(env, path);
+  }
+
+  exports.Set("startTracing", Napi::Function::New(env, StartTracing));
+  exports.Set("stopTracing", Napi::Function::New(env, StopTracing));
+}
+
+}  // namespace node_webrtc
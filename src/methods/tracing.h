@@ -0,0 +1,35 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <string>
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * Tracing exposes EventTracer to JavaScript as `startTracing(path)` and
+ * `stopTracing()`. Setting the NODE_WEBRTC_TRACE_FILE environment variable
+ * starts tracing to that file as soon as the module loads.
+ */
+class Tracing {
+ public:
+  static void Init(Napi::Env, Napi::Object);
+
+ private:
+  static Napi::Value StartTracing(const Napi::CallbackInfo&);
+  static Napi::Value StopTracing(const Napi::CallbackInfo&);
+
+  static bool Start(Napi::Env, const std::string&);
+  static void Stop(void*);
+};
+
+}  // namespace node_webrtc
@@ -6,11 +6,13 @@
 #include <node-addon-api/napi.h>
 
 #include "src/node/async_context_releaser.h"
+#include "src/node/interned_strings.h"
+#include "src/node/object_census.h"
 
 namespace node_webrtc {
 
 template <typename T>
-class AsyncObjectWrap: public Napi::ObjectWrap<T> {
+class AsyncObjectWrap: public Napi::ObjectWrap<T>, public Counted<T> {
  private:
   Napi::AsyncContext* _async_context;
   std::mutex _async_context_mutex;
@@ -28,7 +30,8 @@ class AsyncObjectWrap: public Napi::ObjectWrap<T> {
   AsyncObjectWrap(
       const char* name,
       const Napi::CallbackInfo& info):
-    Napi::ObjectWrap<T>(info) {
+    Napi::ObjectWrap<T>(info),
+    Counted<T>(name) {
     this->_async_context = new Napi::AsyncContext(info.Env(), name, this->Value());
     AsyncContextReleaser::GetDefault();
   }
@@ -44,7 +47,7 @@ class AsyncObjectWrap: public Napi::ObjectWrap<T> {
  protected:
   void MakeCallback(const char* name, const std::initializer_list<napi_value>& args) {
     auto self = this->Value();
-    auto maybeFunction = self.Get(name);
+    auto maybeFunction = self.Get(InternedStrings::Get(self.Env(), name));
     if (maybeFunction.IsFunction()) {
       _async_context_mutex.lock();
       if (_async_context) {
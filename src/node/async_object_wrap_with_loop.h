@@ -20,15 +20,25 @@ class AsyncObjectWrapWithLoop
       T& target,
       const Napi::CallbackInfo& info) :
     AsyncObjectWrap<T>(name, info),
-    EventLoop<T>(info.Env(), this->context(), target) {
+    EventLoop<T>(info.Env(), this->context(), target, this->census()) {
+    this->census()->DidStart();
     this->Ref();
   }
 
+  /**
+   * Implements `getQueueMetrics()`, which reports the EventQueueMetrics for
+   * this object's EventLoop.
+   */
+  Napi::Value GetQueueMetrics(const Napi::CallbackInfo& info) {
+    return this->metrics().ToNapi(info.Env());
+  }
+
  protected:
   /**
    * This method will be invoked once the AsyncObjectWrapWithLoop stops.
    */
   void DidStop() override {
+    this->census()->DidStop();
     if (!this->IsEmpty())
         this->Unref();
   }
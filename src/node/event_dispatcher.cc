@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/event_dispatcher.h"
+
+#include <algorithm>
+
+#include <webrtc/rtc_base/trace_event.h>
+
+#include "src/node/event_queue_metrics.h"
+
+std::unordered_map<napi_env, node_webrtc::EventDispatcher*>& node_webrtc::EventDispatcher::_dispatchers() {
+  // An env, and so its cleanup hook, belongs to one thread, so each worker
+  // thread keeps its own map and needs no lock.
+  static thread_local std::unordered_map<napi_env, EventDispatcher*> dispatchers;
+  return dispatchers;
+}
+
+node_webrtc::EventDispatcher* node_webrtc::EventDispatcher::For(Napi::Env env) {
+  auto& dispatchers = _dispatchers();
+  auto it = dispatchers.find(env);
+  if (it != dispatchers.end()) {
+    return it->second;
+  }
+
+  uv_loop_t* loop;
+  auto status = napi_get_uv_event_loop(env, &loop);
+  {
+    using Napi::Error;
+    NAPI_THROW_IF_FAILED(env, status, nullptr);
+  }
+
+  auto dispatcher = new EventDispatcher(loop);
+  napi_add_env_cleanup_hook(env, Dispose, static_cast<napi_env>(env));
+  dispatchers.emplace(env, dispatcher);
+  return dispatcher;
+}
+
+node_webrtc::EventDispatcher::EventDispatcher(uv_loop_t* loop) {
+  uv_async_init(loop, &_async, [](auto handle) {
+    static_cast<EventDispatcher*>(handle->data)->Drain();
+  });
+  _async.data = this;
+  uv_unref(reinterpret_cast<uv_handle_t*>(&_async));
+}
+
+void node_webrtc::EventDispatcher::Register(Runnable*) {
+  if (_registered++ == 0) {
+    uv_ref(reinterpret_cast<uv_handle_t*>(&_async));
+  }
+}
+
+void node_webrtc::EventDispatcher::Unregister(Runnable* runnable) {
+  _mutex.lock();
+  for (auto i = 0; i < 2; i++) {
+    if (runnable->_scheduled[i]) {
+      _ready[i].erase(std::remove(_ready[i].begin(), _ready[i].end(), runnable), _ready[i].end());
+      runnable->_scheduled[i] = false;
+    }
+  }
+  _mutex.unlock();
+  if (--_registered == 0) {
+    uv_unref(reinterpret_cast<uv_handle_t*>(&_async));
+  }
+}
+
+void node_webrtc::EventDispatcher::Schedule(Runnable* runnable, EventLane lane) {
+  auto i = static_cast<size_t>(lane);
+  _mutex.lock();
+  auto wake = !_closed && !runnable->_scheduled[i];
+  if (wake) {
+    runnable->_scheduled[i] = true;
+    _ready[i].push_back(runnable);
+    uv_async_send(&_async);
+  }
+  _mutex.unlock();
+}
+
+void node_webrtc::EventDispatcher::SetBudget(uint64_t maxTime, uint32_t maxEvents) {
+  _maxTime = maxTime;
+  _maxEvents = maxEvents;
+}
+
+bool node_webrtc::EventDispatcher::IsBudgetExhausted() const {
+  return (_maxEvents && _eventsThisWakeup >= _maxEvents)
+      || (_maxTime && uv_hrtime() - _wakeupStartedAt >= _maxTime);
+}
+
+bool node_webrtc::EventDispatcher::DidDispatchEvent() {
+  _eventsThisWakeup++;
+  return IsBudgetExhausted();
+}
+
+void node_webrtc::EventDispatcher::Drain() {
+  TRACE_EVENT0("node_webrtc", "EventDispatcher::Drain");
+  _wakeups++;
+  _wakeupStartedAt = uv_hrtime();
+  _eventsThisWakeup = 0;
+  DrainReady();
+  EventQueueMetrics::Aggregate().DidWakeUp(_eventsThisWakeup);
+}
+
+void node_webrtc::EventDispatcher::DrainReady() {
+  // Only run what was ready when we woke up. Runnables that schedule
+  // themselves again while we drain wait for the next wake-up, so that a busy
+  // Runnable cannot keep us here forever.
+  _mutex.lock();
+  size_t remaining[2] = { _ready[0].size(), _ready[1].size() };
+  _mutex.unlock();
+
+  for (size_t i = 0; i < 2; i++) {
+    while (remaining[i]--) {
+      // Pop one at a time, rather than swapping out the whole ready-list, so
+      // that a Runnable that unregisters while we drain (and may then be
+      // destroyed) is never run.
+      _mutex.lock();
+      if (_ready[i].empty()) {
+        _mutex.unlock();
+        break;
+      }
+      auto runnable = _ready[i].front();
+      _ready[i].pop_front();
+      runnable->_scheduled[i] = false;
+      _mutex.unlock();
+
+      runnable->Run();
+
+      if (IsBudgetExhausted()) {
+        // Whatever is still ready runs on the next wake-up, after the rest of
+        // the Node loop has had a turn.
+        _mutex.lock();
+        if (!_ready[0].empty() || !_ready[1].empty()) {
+          _yields++;
+          uv_async_send(&_async);
+        }
+        _mutex.unlock();
+        return;
+      }
+    }
+  }
+}
+
+void node_webrtc::EventDispatcher::Dispose(void* arg) {
+  auto& dispatchers = _dispatchers();
+  auto it = dispatchers.find(static_cast<napi_env>(arg));
+  if (it == dispatchers.end()) {
+    return;
+  }
+  auto dispatcher = it->second;
+  dispatchers.erase(it);
+
+  // Objects that outlive the env may still call Schedule from other threads,
+  // so the dispatcher itself is leaked on purpose; only its handle is closed.
+  dispatcher->_mutex.lock();
+  dispatcher->_closed = true;
+  dispatcher->_ready[0].clear();
+  dispatcher->_ready[1].clear();
+  uv_close(reinterpret_cast<uv_handle_t*>(&dispatcher->_async), nullptr);
+  dispatcher->_mutex.unlock();
+}
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include <node-addon-api/napi.h>
+#include <uv.h>
+
+#include "src/node/events.h"
+
+namespace node_webrtc {
+
+/**
+ * EventDispatcher multiplexes every EventLoop in a napi_env onto a single
+ * uv_async_t. An EventLoop with pending events schedules itself on one of the
+ * dispatcher's ready-lists, one per EventLane; one wake-up then runs every
+ * EventLoop that was ready, control lane first, and otherwise in the order
+ * they were scheduled.
+ *
+ * The uv_async_t keeps the Node loop alive only while at least one Runnable is
+ * registered, just as each EventLoop's own uv_async_t used to.
+ *
+ * Each wake-up has a budget, in time and in events dispatched. Once it is
+ * exhausted, the dispatcher yields to the rest of the Node loop (timers, I/O)
+ * and re-arms itself to carry on where it left off.
+ *
+ * Schedule is thread-safe. Everything else must be called on the env's main
+ * thread.
+ */
+class EventDispatcher {
+ public:
+  class Runnable {
+   public:
+    virtual ~Runnable() = default;
+
+    /**
+     * Run is invoked on the main thread once per wake-up after the Runnable
+     * has been scheduled.
+     */
+    virtual void Run() = 0;
+
+   private:
+    friend class EventDispatcher;
+
+    // Guarded by the dispatcher's _mutex; indexed by EventLane.
+    bool _scheduled[2] = {false, false};
+  };
+
+  /**
+   * Get the EventDispatcher for a napi_env, creating it on first use.
+   * @return the EventDispatcher, or nullptr (with a pending exception) if the
+   * env has no uv_loop_t
+   */
+  static EventDispatcher* For(Napi::Env);
+
+  /**
+   * Register a Runnable, keeping the Node loop alive until it is unregistered.
+   */
+  void Register(Runnable*);
+
+  /**
+   * Unregister a Runnable, removing it from the ready-lists. Once this returns,
+   * the dispatcher will not run it again, so it is safe to destroy.
+   */
+  void Unregister(Runnable*);
+
+  /**
+   * Schedule a registered Runnable to run on the next wake-up. Scheduling a
+   * Runnable that is already on the lane's ready-list does nothing.
+   */
+  void Schedule(Runnable*, EventLane = EventLane::kControl);
+
+  /**
+   * Set the budget for each wake-up. Zero means unlimited.
+   * @param maxTime the most time to spend per wake-up, in nanoseconds
+   * @param maxEvents the most events to dispatch per wake-up
+   */
+  void SetBudget(uint64_t maxTime, uint32_t maxEvents);
+
+  /**
+   * Runnables call this after dispatching each event.
+   * @return true if the current wake-up's budget is exhausted, in which case
+   * the Runnable should Schedule itself and return from Run
+   */
+  bool DidDispatchEvent();
+
+  /**
+   * The number of times the dispatcher has woken up.
+   */
+  uint64_t wakeups() const {
+    return _wakeups;
+  }
+
+  /**
+   * The number of wake-ups that exhausted their budget and yielded with work
+   * still ready.
+   */
+  uint64_t yields() const {
+    return _yields;
+  }
+
+  /**
+   * By default, each wake-up may run for up to 10 ms and dispatch any number
+   * of events.
+   */
+  static const uint64_t kDefaultMaxTime = 10 * 1000 * 1000;
+
+ private:
+  explicit EventDispatcher(uv_loop_t*);
+
+  void Drain();
+  void DrainReady();
+  bool IsBudgetExhausted() const;
+
+  static void Dispose(void*);
+
+  static std::unordered_map<napi_env, EventDispatcher*>& _dispatchers();
+
+  uv_async_t _async{};
+  std::mutex _mutex{};
+  std::deque<Runnable*> _ready[2];  // Guarded by _mutex; indexed by EventLane
+  bool _closed = false;  // Guarded by _mutex
+  size_t _registered = 0;
+
+  uint64_t _maxTime = kDefaultMaxTime;
+  uint32_t _maxEvents = 0;
+  uint64_t _wakeupStartedAt = 0;
+  uint32_t _eventsThisWakeup = 0;
+  uint64_t _wakeups = 0;
+  uint64_t _yields = 0;
+};
+
+}  // namespace node_webrtc
@@ -4,70 +4,92 @@
 #include <mutex>
 
 #include <node-addon-api/napi.h>
-#include <uv.h>
+#include <webrtc/rtc_base/trace_event.h>
 
+#include "src/node/event_dispatcher.h"
 #include "src/node/event_queue.h"
 #include "src/node/events.h"
+#include "src/node/object_census.h"
 
 namespace node_webrtc {
 
+/**
+ * EventLoop queues Events for a target and dispatches them on the main
+ * thread. Rather than owning a uv_async_t, every EventLoop in a napi_env
+ * shares that env's EventDispatcher.
+ * @tparam T the Event target type
+ */
 template <typename T>
-class EventLoop: private EventQueue<T> {
+class EventLoop: private EventQueue<T>, private EventDispatcher::Runnable {
  public:
   virtual ~EventLoop() = default;
 
-  void Dispatch(std::unique_ptr<Event<T>> event) {
-    this->Enqueue(std::move(event));
-    _lock.lock();
-    if (!uv_is_closing(reinterpret_cast<uv_handle_t*>(&_async))) {
-      uv_async_send(&_async);
-    }
-    _lock.unlock();
+  void Dispatch(std::unique_ptr<Event<T>> event, EventLane lane = EventLane::kControl) {
+    this->Enqueue(std::move(event), lane);
+    Schedule(lane);
+  }
+
+  /**
+   * Dispatch a media Event, dropping any media Events that have not been
+   * dispatched yet. Use this for media where only the newest matters, such as
+   * video frames for display.
+   * @return the number of Events dropped
+   */
+  size_t DispatchCoalesced(std::unique_ptr<Event<T>> event) {
+    auto dropped = this->EnqueueCoalesced(std::move(event));
+    Schedule(EventLane::kMedia);
+    return dropped;
   }
 
   bool should_stop() const {
     return _should_stop;
   }
 
+  using EventQueue<T>::metrics;
+
  protected:
-  EventLoop(Napi::Env env, Napi::AsyncContext* context, T& target): _context(context), _env(env), _target(target) {
-    uv_loop_t* loop;
-    auto status = napi_get_uv_event_loop(_env, &loop);
-    {
-      using Napi::Error;
-      NAPI_THROW_IF_FAILED_VOID(_env, status);
+  EventLoop(Napi::Env env, Napi::AsyncContext* context, T& target, ObjectCensus::Entry* census = nullptr)
+    : EventQueue<T>(census), _context(context), _env(env), _target(target) {
+    _dispatcher = EventDispatcher::For(_env);
+    if (_dispatcher) {
+      _dispatcher->Register(this);
     }
-
-    uv_async_init(loop, &_async, [](auto handle) {
-      auto self = static_cast<EventLoop<T>*>(handle->data);
-      self->Run();
-    });
-
-    _async.data = this;
   }
 
   virtual void DidStop() {
     // Do nothing.
   }
 
-  virtual void Run() {
+  void Run() override {
     Napi::HandleScope scope(_env);
+    size_t dispatched = 0;
     if (!_should_stop) {
       while (auto event = this->Dequeue()) {
+        TRACE_EVENT0("node_webrtc", "EventLoop::Dispatch");
         Napi::CallbackScope callbackScope(_env, *_context);
         event->Dispatch(_target);
+        dispatched++;
         if (_should_stop) {
           break;
         }
+        if (_dispatcher->DidDispatchEvent()) {
+          // Out of budget; dispatch the rest on a later wake-up.
+          _dispatcher->Schedule(this, this->HasControlEvents() ? EventLane::kControl : EventLane::kMedia);
+          break;
+        }
       }
     }
-    if (_should_stop) {
+    // A loop scheduled in both lanes runs twice; the second run usually finds
+    // nothing left, and is not a wake-up worth counting.
+    if (dispatched) {
+      this->metrics().DidWakeUp(dispatched);
+    }
+    if (_should_stop && !_stopped) {
       _lock.lock();
-      uv_close(reinterpret_cast<uv_handle_t*>(&_async), [](auto handle) {
-        auto self = static_cast<EventLoop<T>*>(handle->data);
-        self->DidStop();
-      });
+      _stopped = true;
+      _dispatcher->Unregister(this);
       _lock.unlock();
+      DidStop();
     }
   }
 
@@ -77,11 +99,20 @@ class EventLoop: private EventQueue<T> {
   }
 
  private:
-  uv_async_t _async{};
+  void Schedule(EventLane lane) {
+    _lock.lock();
+    if (_dispatcher && !_stopped) {
+      _dispatcher->Schedule(this, lane);
+    }
+    _lock.unlock();
+  }
+
   Napi::AsyncContext* _context;
+  EventDispatcher* _dispatcher = nullptr;
   Napi::Env _env;
   std::mutex _lock{};
   std::atomic<bool> _should_stop = {false};
+  bool _stopped = false;  // Guarded by _lock
   T& _target;
 };
 
@@ -9,32 +9,86 @@
  */
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <queue>
 
+#include <webrtc/rtc_base/trace_event.h>
+
 #include "events.h"
+#include "src/node/event_queue_metrics.h"
+#include "src/node/object_census.h"
 
 namespace node_webrtc {
 
 /**
  * EventQueue is a thread-safe Event queue. It allows you to enqueue events
- * from one thread and dequeue them from another (or the same).
+ * from one thread and dequeue them from another (or the same). Events in the
+ * control lane are dequeued before Events in the media lane; within a lane,
+ * Events are dequeued in the order they were enqueued.
+ *
+ * EventQueue records its depth and how long each Event waited in its
+ * EventQueueMetrics, as well as in the process-wide aggregate, and counts its
+ * pending Events in its target type's ObjectCensus Entry, if any.
  * @tparam T the Event target type
  */
 template <typename T>
 class EventQueue {
  public:
+  explicit EventQueue(ObjectCensus::Entry* census = nullptr): _census(census) {}
+
+  ~EventQueue() {
+    auto remaining = _control.size() + _media.size();
+    if (remaining) {
+      EventQueueMetrics::Aggregate().DidDrop(remaining);
+      if (_census) {
+        _census->DidDequeue(remaining);
+      }
+    }
+  }
+
   /**
    * Enqueue an Event.
    * @param event the event to enqueue
+   * @param lane the lane to enqueue it in
    */
-  void Enqueue(std::unique_ptr<Event<T>> event) {
+  void Enqueue(std::unique_ptr<Event<T>> event, EventLane lane = EventLane::kControl) {
+    TRACE_EVENT_INSTANT1("node_webrtc", "EventQueue::Enqueue", "lane", static_cast<int>(lane));
+    Entry entry = { Now(), std::move(event) };
     _mutex.lock();
-    _events.push(std::move(event));
+    (lane == EventLane::kControl ? _control : _media).push(std::move(entry));
+    DidEnqueue();
     _mutex.unlock();
   }
 
+  /**
+   * Enqueue a media Event, dropping any media Events that have not been
+   * dequeued yet, so that only the newest one is dispatched.
+   * @param event the event to enqueue
+   * @return the number of Events dropped
+   */
+  size_t EnqueueCoalesced(std::unique_ptr<Event<T>> event) {
+    TRACE_EVENT_INSTANT0("node_webrtc", "EventQueue::EnqueueCoalesced");
+    Entry entry = { Now(), std::move(event) };
+    std::queue<Entry> dropped;
+    _mutex.lock();
+    dropped.swap(_media);
+    _media.push(std::move(entry));
+    DidEnqueue();
+    if (!dropped.empty()) {
+      _metrics.DidDrop(dropped.size());
+      EventQueueMetrics::Aggregate().DidDrop(dropped.size());
+      if (_census) {
+        _census->DidDequeue(dropped.size());
+      }
+    }
+    _mutex.unlock();
+    // The dropped Events are destroyed here, outside of the lock.
+    return dropped.size();
+  }
+
   /**
    * Attempt to dequeue an Event. If the EventQueue is empty, this method
    * returns nullptr.
@@ -42,19 +96,61 @@ class EventQueue {
    */
   std::unique_ptr<Event<T>> Dequeue() {
     _mutex.lock();
-    if (_events.empty()) {
+    auto& events = _control.empty() ? _media : _control;
+    if (events.empty()) {
       _mutex.unlock();
       return nullptr;
     }
-    auto event = std::move(_events.front());
-    _events.pop();
+    auto entry = std::move(events.front());
+    events.pop();
+    auto latency = Now() - entry.enqueuedAt;
+    _metrics.DidDispatch(latency);
+    EventQueueMetrics::Aggregate().DidDispatch(latency);
+    if (_census) {
+      _census->DidDequeue();
+    }
     _mutex.unlock();
-    return event;
+    return std::move(entry.event);
+  }
+
+  /**
+   * @return true if there are Events in the control lane
+   */
+  bool HasControlEvents() {
+    _mutex.lock();
+    auto result = !_control.empty();
+    _mutex.unlock();
+    return result;
+  }
+
+  EventQueueMetrics& metrics() {
+    return _metrics;
   }
 
  private:
-  std::queue<std::unique_ptr<Event<T>>> _events;
+  struct Entry {
+    uint64_t enqueuedAt;
+    std::unique_ptr<Event<T>> event;
+  };
+
+  static uint64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  void DidEnqueue() {
+    _metrics.DidEnqueue();
+    EventQueueMetrics::Aggregate().DidEnqueue();
+    if (_census) {
+      _census->DidEnqueue();
+    }
+  }
+
+  std::queue<Entry> _control;
+  std::queue<Entry> _media;
   std::mutex _mutex{};
+  EventQueueMetrics _metrics;
+  ObjectCensus::Entry* _census;
 };
 
 }  // namespace node_webrtc
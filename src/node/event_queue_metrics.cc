@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/event_queue_metrics.h"
+
+#include <limits>
+
+#include "src/node/interned_strings.h"
+
+namespace node_webrtc {
+
+const uint64_t EventQueueMetrics::kLatencyBucketBounds[kLatencyBuckets] = {
+  10, 20, 50, 100, 200, 500,
+  1000, 2000, 5000, 10000, 20000, 50000,
+  100000, 200000, 500000, 1000000
+};
+
+EventQueueMetrics& EventQueueMetrics::Aggregate() {
+  // Leaked on purpose, so that EventLoops destroyed during shutdown can still
+  // report to it.
+  static auto aggregate = new EventQueueMetrics();
+  return *aggregate;
+}
+
+void EventQueueMetrics::Max(std::atomic<uint64_t>& max, uint64_t value) {
+  auto current = max.load(std::memory_order_relaxed);
+  while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+void EventQueueMetrics::DidEnqueue(size_t count) {
+  _enqueued.fetch_add(count, std::memory_order_relaxed);
+  auto depth = _depth.fetch_add(count, std::memory_order_relaxed) + count;
+  Max(_highWaterDepth, depth);
+}
+
+void EventQueueMetrics::DidDrop(size_t count) {
+  _dropped.fetch_add(count, std::memory_order_relaxed);
+  _depth.fetch_sub(count, std::memory_order_relaxed);
+}
+
+void EventQueueMetrics::DidDispatch(uint64_t latency) {
+  _dispatched.fetch_add(1, std::memory_order_relaxed);
+  _depth.fetch_sub(1, std::memory_order_relaxed);
+  _latencySum.fetch_add(latency, std::memory_order_relaxed);
+  Max(_latencyMax, latency);
+  size_t bucket = 0;
+  while (bucket < kLatencyBuckets && latency > kLatencyBucketBounds[bucket] * 1000) {
+    bucket++;
+  }
+  _latencyCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void EventQueueMetrics::DidWakeUp(size_t dispatched) {
+  _wakeups.fetch_add(1, std::memory_order_relaxed);
+  _wakeupEvents.fetch_add(dispatched, std::memory_order_relaxed);
+  Max(_wakeupEventsMax, dispatched);
+}
+
+Napi::Value EventQueueMetrics::ToNapi(Napi::Env env) const {
+  auto number = [](const std::atomic<uint64_t>& value) {
+    return static_cast<double>(value.load(std::memory_order_relaxed));
+  };
+
+  auto dispatched = number(_dispatched);
+  auto latency = Napi::Object::New(env);
+  latency.Set(InternedStrings::Get(env, "mean"), dispatched ? number(_latencySum) / dispatched / 1e6 : 0);
+  latency.Set(InternedStrings::Get(env, "max"), number(_latencyMax) / 1e6);
+  auto buckets = Napi::Array::New(env, kLatencyBuckets + 1);
+  for (size_t i = 0; i <= kLatencyBuckets; i++) {
+    auto bucket = Napi::Object::New(env);
+    bucket.Set(InternedStrings::Get(env, "le"), i < kLatencyBuckets
+        ? kLatencyBucketBounds[i] / 1e3
+        : std::numeric_limits<double>::infinity());
+    bucket.Set(InternedStrings::Get(env, "count"), number(_latencyCounts[i]));
+    buckets.Set(static_cast<uint32_t>(i), bucket);
+  }
+  latency.Set(InternedStrings::Get(env, "buckets"), buckets);
+
+  auto wakeups = number(_wakeups);
+  auto eventsPerWakeup = Napi::Object::New(env);
+  eventsPerWakeup.Set(InternedStrings::Get(env, "mean"), wakeups ? number(_wakeupEvents) / wakeups : 0);
+  eventsPerWakeup.Set(InternedStrings::Get(env, "max"), number(_wakeupEventsMax));
+
+  auto object = Napi::Object::New(env);
+  object.Set(InternedStrings::Get(env, "depth"), number(_depth));
+  object.Set(InternedStrings::Get(env, "highWaterDepth"), number(_highWaterDepth));
+  object.Set(InternedStrings::Get(env, "enqueued"), number(_enqueued));
+  object.Set(InternedStrings::Get(env, "dispatched"), dispatched);
+  object.Set(InternedStrings::Get(env, "dropped"), number(_dropped));
+  object.Set(InternedStrings::Get(env, "latency"), latency);
+  object.Set(InternedStrings::Get(env, "wakeups"), wakeups);
+  object.Set(InternedStrings::Get(env, "eventsPerWakeup"), eventsPerWakeup);
+  return object;
+}
+
+}  // namespace node_webrtc
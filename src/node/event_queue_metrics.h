@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * EventQueueMetrics records how far behind an EventLoop is: how many Events
+ * are queued, how long each Event waited between being enqueued and being
+ * dispatched, and how many Events each wake-up dispatched.
+ *
+ * Every EventLoop keeps its own EventQueueMetrics and also feeds the
+ * process-wide aggregate returned by Aggregate. Recording is lock-free, so
+ * Events can be enqueued on libwebrtc's threads while JavaScript reads the
+ * metrics on the main thread.
+ */
+class EventQueueMetrics {
+ public:
+  /**
+   * The upper bounds, in microseconds, of the latency histogram's buckets. A
+   * final bucket counts everything slower.
+   */
+  static const size_t kLatencyBuckets = 16;
+  static const uint64_t kLatencyBucketBounds[kLatencyBuckets];
+
+  void DidEnqueue(size_t count = 1);
+  void DidDrop(size_t count);
+  void DidDispatch(uint64_t latency);
+  void DidWakeUp(size_t dispatched);
+
+  /**
+   * Convert the metrics to a plain JavaScript object (see
+   * docs/nonstandard-apis.md for its shape).
+   */
+  Napi::Value ToNapi(Napi::Env) const;
+
+  /**
+   * The process-wide aggregate of every EventLoop's metrics. Its wake-ups
+   * count EventDispatcher wake-ups, rather than EventLoop runs.
+   */
+  static EventQueueMetrics& Aggregate();
+
+ private:
+  static void Max(std::atomic<uint64_t>&, uint64_t);
+
+  std::atomic<uint64_t> _depth = {0};
+  std::atomic<uint64_t> _highWaterDepth = {0};
+  std::atomic<uint64_t> _enqueued = {0};
+  std::atomic<uint64_t> _dispatched = {0};
+  std::atomic<uint64_t> _dropped = {0};
+  std::atomic<uint64_t> _latencySum = {0};
+  std::atomic<uint64_t> _latencyMax = {0};
+  std::atomic<uint64_t> _latencyCounts[kLatencyBuckets + 1] = {};
+  std::atomic<uint64_t> _wakeups = {0};
+  std::atomic<uint64_t> _wakeupEvents = {0};
+  std::atomic<uint64_t> _wakeupEventsMax = {0};
+};
+
+}  // namespace node_webrtc
@@ -14,6 +14,17 @@
 
 namespace node_webrtc {
 
+/**
+ * EventLane classifies Events by urgency. Control Events (state changes,
+ * errors, resolving promises) are always dispatched ahead of Media Events
+ * (video frames, audio data), so that they are not stuck behind a backlog of
+ * media under load.
+ */
+enum class EventLane {
+  kControl,
+  kMedia
+};
+
 /**
  * Event represents an event that can be dispatched to a target.
  * @tparam T the target type
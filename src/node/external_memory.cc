@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/external_memory.h"
+
+#include "src/node/interned_strings.h"
+
+namespace node_webrtc {
+
+std::atomic<int64_t> ExternalMemory::_bytes[kNumberOfCategories] = {};
+
+Napi::ArrayBuffer ExternalMemory::NewArrayBuffer(Napi::Env env, Category category, uint8_t* data, size_t byteLength) {
+  auto arrayBuffer = Napi::ArrayBuffer::New(env, data, byteLength, [category, byteLength](Napi::Env env, void* data) {
+    delete[] static_cast<uint8_t*>(data);
+    _bytes[category].fetch_sub(byteLength, std::memory_order_relaxed);
+  });
+  if (env.IsExceptionPending()) {
+    delete[] data;
+    return arrayBuffer;
+  }
+  _bytes[category].fetch_add(byteLength, std::memory_order_relaxed);
+  return arrayBuffer;
+}
+
+int64_t ExternalMemory::bytes(Category category) {
+  return _bytes[category].load(std::memory_order_relaxed);
+}
+
+Napi::Value ExternalMemory::ToNapi(Napi::Env env) {
+  static const char* names[kNumberOfCategories] = {
+    "videoFrames",
+    "audioData",
+    "dataChannelMessages",
+    "buffers"
+  };
+  auto object = Napi::Object::New(env);
+  int64_t total = 0;
+  for (int i = 0; i < kNumberOfCategories; i++) {
+    auto value = bytes(static_cast<Category>(i));
+    object.Set(InternedStrings::Get(env, names[i]), static_cast<double>(value));
+    total += value;
+  }
+  object.Set(InternedStrings::Get(env, "total"), static_cast<double>(total));
+  return object;
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * ExternalMemory creates ArrayBuffers backed by native memory and keeps a
+ * running, process-wide total of these bytes for each Category, until each
+ * ArrayBuffer is finalized. It does not adjust V8's external memory: Node
+ * already reports an external ArrayBuffer's backing store to V8.
+ */
+class ExternalMemory {
+ public:
+  enum Category {
+    kVideoFrames,
+    kAudioData,
+    kDataChannelMessages,
+    kBuffers,
+    kNumberOfCategories
+  };
+
+  /**
+   * Create an ArrayBuffer that takes ownership of data allocated with new[].
+   * If creating the ArrayBuffer fails, data is deleted and an exception is
+   * left pending on the env.
+   */
+  static Napi::ArrayBuffer NewArrayBuffer(Napi::Env, Category, uint8_t* data, size_t byteLength);
+
+  /**
+   * The bytes currently held by ArrayBuffers in a Category.
+   */
+  static int64_t bytes(Category);
+
+  /**
+   * Convert the running totals to a JavaScript object, keyed by Category
+   * name, with a "total" property.
+   */
+  static Napi::Value ToNapi(Napi::Env);
+
+ private:
+  static std::atomic<int64_t> _bytes[kNumberOfCategories];
+};
+
+}  // namespace node_webrtc
@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/interned_strings.h"
+
+#include <utility>
+
+std::unordered_map<napi_env, std::unique_ptr<node_webrtc::InternedStrings::Cache>>& node_webrtc::InternedStrings::_caches() {
+  // An env, and so its cleanup hook, belongs to one thread, so each worker
+  // thread keeps its own map and lookups need no lock. Leaked on purpose; each
+  // Cache is torn down by its env's cleanup hook, while the env is still able
+  // to delete references.
+  static thread_local auto caches = new std::unordered_map<napi_env, std::unique_ptr<Cache>>();
+  return *caches;
+}
+
+node_webrtc::InternedStrings::Cache& node_webrtc::InternedStrings::GetCache(Napi::Env env) {
+  auto& caches = _caches();
+  auto it = caches.find(env);
+  if (it != caches.end()) {
+    return *it->second;
+  }
+  napi_add_env_cleanup_hook(env, Dispose, static_cast<napi_env>(env));
+  auto result = caches.emplace(env, std::unique_ptr<Cache>(new Cache()));
+  return *result.first->second;
+}
+
+void node_webrtc::InternedStrings::Dispose(void* arg) {
+  _caches().erase(static_cast<napi_env>(arg));
+}
+
+Napi::String node_webrtc::InternedStrings::Get(Napi::Env env, const char* name) {
+  auto& cache = GetCache(env);
+  auto it = cache.find(name);
+  if (it != cache.end()) {
+    return it->second.Value();
+  }
+  auto string = Napi::String::New(env, name);
+  cache.emplace(name, Napi::Persistent(string));
+  return string;
+}
+
+size_t node_webrtc::InternedStrings::size(Napi::Env env) {
+  return GetCache(env).size();
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * InternedStrings caches one persistent Napi::String per napi_env for each
+ * property name (or constant value, such as an event type) we set on objects
+ * handed to JavaScript. Hot paths like event construction and TO_NAPI
+ * conversions can then reuse the same V8 string instead of allocating and
+ * internalizing a new one every time.
+ *
+ * Entries are keyed by pointer, not by contents, so only pass strings with
+ * static storage duration: string literals, or names owned by libwebrtc for
+ * the lifetime of the process (for example, RTCStatsMemberInterface::name).
+ */
+class InternedStrings {
+ public:
+  /**
+   * Get the cached string for name, creating it on first use. name must have
+   * static storage duration, such as a string literal: the cache is keyed by
+   * the pointer, and never copies or frees it.
+   */
+  static Napi::String Get(Napi::Env, const char* name);
+
+  /**
+   * The number of strings cached for an env.
+   */
+  static size_t size(Napi::Env);
+
+ private:
+  typedef std::unordered_map<const char*, Napi::Reference<Napi::String>> Cache;
+
+  static Cache& GetCache(Napi::Env);
+  static void Dispose(void*);
+
+  static std::unordered_map<napi_env, std::unique_ptr<Cache>>& _caches();
+};
+
+}  // namespace node_webrtc
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/node/object_census.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "src/node/external_memory.h"
+#include "src/node/interned_strings.h"
+
+namespace node_webrtc {
+
+struct Entries {
+  std::mutex mutex;
+  std::map<std::string, ObjectCensus::Entry*> map;
+};
+
+static Entries& GetEntries() {
+  // Leaked on purpose, along with every Entry, so that objects destroyed
+  // during shutdown can still report to them.
+  static auto entries = new Entries();
+  return *entries;
+}
+
+ObjectCensus::Entry* ObjectCensus::Get(const char* type) {
+  auto& entries = GetEntries();
+  std::lock_guard<std::mutex> lock(entries.mutex);
+  auto& entry = entries.map[type];
+  if (!entry) {
+    entry = new Entry();
+  }
+  return entry;
+}
+
+Napi::Value ObjectCensus::ToNapi(Napi::Env env) {
+  auto objects = Napi::Object::New(env);
+  int64_t pendingEvents = 0;
+  {
+    auto& entries = GetEntries();
+    std::lock_guard<std::mutex> lock(entries.mutex);
+    for (const auto& pair : entries.map) {
+      auto entry = pair.second;
+      auto counts = Napi::Object::New(env);
+      counts.Set(InternedStrings::Get(env, "live"), static_cast<double>(entry->_live.load(std::memory_order_relaxed)));
+      counts.Set(InternedStrings::Get(env, "running"), static_cast<double>(entry->_running.load(std::memory_order_relaxed)));
+      auto pending = entry->_pendingEvents.load(std::memory_order_relaxed);
+      counts.Set(InternedStrings::Get(env, "pendingEvents"), static_cast<double>(pending));
+      objects.Set(pair.first, counts);
+      pendingEvents += pending;
+    }
+  }
+  auto census = Napi::Object::New(env);
+  census.Set(InternedStrings::Get(env, "objects"), objects);
+  census.Set(InternedStrings::Get(env, "pendingEvents"), static_cast<double>(pendingEvents));
+  census.Set(InternedStrings::Get(env, "external"), ExternalMemory::ToNapi(env));
+  return census;
+}
+
+}  // namespace node_webrtc
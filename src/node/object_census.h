@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <node-addon-api/napi.h>
+
+namespace node_webrtc {
+
+/**
+ * ObjectCensus counts the native objects we have wrapped, by type: how many
+ * are alive, how many AsyncObjectWrapWithLoops are still running (and so hold
+ * a reference to themselves), and how many Events are waiting to be
+ * dispatched to them. An object that never stops keeps everything it
+ * references alive, so a running count that only grows is usually a leak.
+ *
+ * Counting is lock-free; only the first object of each type takes a lock, to
+ * register its Entry.
+ */
+class ObjectCensus {
+ public:
+  class Entry {
+   public:
+    void DidCreate() { _live.fetch_add(1, std::memory_order_relaxed); }
+    void DidDestroy() { _live.fetch_sub(1, std::memory_order_relaxed); }
+    void DidStart() { _running.fetch_add(1, std::memory_order_relaxed); }
+    void DidStop() { _running.fetch_sub(1, std::memory_order_relaxed); }
+    void DidEnqueue(size_t count = 1) { _pendingEvents.fetch_add(count, std::memory_order_relaxed); }
+    void DidDequeue(size_t count = 1) { _pendingEvents.fetch_sub(count, std::memory_order_relaxed); }
+
+   private:
+    friend class ObjectCensus;
+
+    std::atomic<int64_t> _live = {0};
+    std::atomic<int64_t> _running = {0};
+    std::atomic<int64_t> _pendingEvents = {0};
+  };
+
+  /**
+   * Get the Entry for a type, registering it on first use. Entries are never
+   * removed, so the pointer remains valid for the life of the process.
+   */
+  static Entry* Get(const char* type);
+
+  /**
+   * Convert the census to a plain JavaScript object (see
+   * docs/nonstandard-apis.md for its shape).
+   */
+  static Napi::Value ToNapi(Napi::Env);
+};
+
+/**
+ * Counted counts every instance of T in the ObjectCensus. Wrapped classes
+ * inherit from it alongside Napi::ObjectWrap.
+ * @tparam T the wrapped type
+ */
+template <typename T>
+class Counted {
+ public:
+  Counted(const Counted&) = delete;
+  Counted& operator=(const Counted&) = delete;
+
+  ObjectCensus::Entry* census() const {
+    return _census;
+  }
+
+ protected:
+  explicit Counted(const char* type): _census(Register(type)) {
+    _census->DidCreate();
+  }
+
+  ~Counted() {
+    _census->DidDestroy();
+  }
+
+ private:
+  static ObjectCensus::Entry* Register(const char* type) {
+    static auto entry = ObjectCensus::Get(type);
+    return entry;
+  }
+
+  ObjectCensus::Entry* _census;
+};
+
+}  // namespace node_webrtc
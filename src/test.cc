@@ -11,11 +11,25 @@
 
 #include "src/test.h"
 
+#include <string>
+#include <vector>
+
+#include <webrtc/api/video/i420_buffer.h>
+
 #define CATCH_CONFIG_RUNNER
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 
 #include "src/converters.h"
+#include "src/converters/arguments.h"
 #include "src/converters/napi.h"
+#include "src/dictionaries/node_webrtc/image_data.h"
+#include "src/dictionaries/node_webrtc/rtc_on_data_event_dict.h"
+#include "src/dictionaries/node_webrtc/rtc_session_description_init.h"
+#include "src/dictionaries/webrtc/video_frame_buffer.h"
+#include "src/functional/maybe.h"
+#include "src/node/external_memory.h"
+#include "src/node/interned_strings.h"
 
 TEST_CASE("converting booleans", "[converting-booleans]") {
   auto env = *node_webrtc::Test::env;
@@ -110,12 +124,202 @@ TEST_CASE("converting arrays", "[converting-arrays]") {
   }
 }
 
+TEST_CASE("interning strings", "[interning-strings]") {
+  auto env = *node_webrtc::Test::env;
+
+  SECTION("caches a name on first use only") {
+    static const char name[] = "interned-strings-test";
+    auto before = node_webrtc::InternedStrings::size(env);
+    auto first = node_webrtc::InternedStrings::Get(env, name);
+    REQUIRE(node_webrtc::InternedStrings::size(env) == before + 1);
+    auto second = node_webrtc::InternedStrings::Get(env, name);
+    REQUIRE(node_webrtc::InternedStrings::size(env) == before + 1);
+    REQUIRE(first.StrictEquals(second));
+    REQUIRE(first.Utf8Value() == "interned-strings-test");
+  }
+
+  SECTION("keys names by pointer, not by contents") {
+    static const char first[] = "interned-strings-key";
+    static const char second[] = "interned-strings-key";
+    auto before = node_webrtc::InternedStrings::size(env);
+    node_webrtc::InternedStrings::Get(env, first);
+    node_webrtc::InternedStrings::Get(env, second);
+    REQUIRE(node_webrtc::InternedStrings::size(env) == before + 2);
+  }
+}
+
+TEST_CASE("accounting external memory", "[external-memory]") {
+  auto env = *node_webrtc::Test::env;
+  Napi::HandleScope scope(env);
+
+  SECTION("counts the bytes held by new ArrayBuffers") {
+    auto before = node_webrtc::ExternalMemory::bytes(node_webrtc::ExternalMemory::kBuffers);
+    auto arrayBuffer = node_webrtc::ExternalMemory::NewArrayBuffer(env, node_webrtc::ExternalMemory::kBuffers, new uint8_t[1024], 1024);
+    REQUIRE(!env.IsExceptionPending());
+    REQUIRE(arrayBuffer.ByteLength() == 1024);
+    REQUIRE(node_webrtc::ExternalMemory::bytes(node_webrtc::ExternalMemory::kBuffers) == before + 1024);
+  }
+
+  SECTION("reports each category and the total") {
+    auto object = node_webrtc::ExternalMemory::ToNapi(env).As<Napi::Object>();
+    double total = 0;
+    for (auto name : { "videoFrames", "audioData", "dataChannelMessages", "buffers" }) {
+      REQUIRE(object.Get(name).IsNumber());
+      total += object.Get(name).As<Napi::Number>().DoubleValue();
+    }
+    REQUIRE(object.Get("total").As<Napi::Number>().DoubleValue() == total);
+  }
+}
+
+static Napi::Object CreateRTCOnDataEventDictObject(Napi::Env env) {
+  auto object = Napi::Object::New(env);
+  object.Set("samples", Napi::Int16Array::New(env, 480));
+  object.Set("sampleRate", 48000);
+  return object;
+}
+
+static Napi::Object CreateImageDataObject(Napi::Env env, int width, int height) {
+  auto object = Napi::Object::New(env);
+  object.Set("width", width);
+  object.Set("height", height);
+  object.Set("data", Napi::Uint8Array::New(env, static_cast<size_t>(width * height * 1.5)));
+  return object;
+}
+
+static Napi::Object CreateRTCSessionDescriptionInitObject(Napi::Env env) {
+  auto object = Napi::Object::New(env);
+  object.Set("type", "offer");
+  object.Set("sdp", "v=0\r\n");
+  return object;
+}
+
+TEST_CASE("converting hot dictionaries", "[converting-hot-dictionaries]") {
+  auto env = *node_webrtc::Test::env;
+  Napi::HandleScope scope(env);
+
+  SECTION("from JavaScript") {
+    SECTION("works for") {
+      SECTION("RTCOnDataEventDict") {
+        auto maybeDict = node_webrtc::From<node_webrtc::RTCOnDataEventDict>(CreateRTCOnDataEventDictObject(env).As<Napi::Value>());
+        REQUIRE(maybeDict.IsValid());
+        auto dict = maybeDict.UnsafeFromValid();
+        REQUIRE(dict.bitsPerSample == 16);
+        REQUIRE(dict.sampleRate == 48000);
+        REQUIRE(dict.channelCount == 1);
+        REQUIRE(dict.numberOfFrames.FromMaybe(0) == 480);
+        delete[] dict.samples;
+      }
+
+      SECTION("ImageData") {
+        auto maybeImageData = node_webrtc::From<node_webrtc::ImageData>(CreateImageDataObject(env, 4, 2).As<Napi::Value>());
+        REQUIRE(maybeImageData.IsValid());
+        REQUIRE(maybeImageData.UnsafeFromValid().width == 4);
+        REQUIRE(maybeImageData.UnsafeFromValid().height == 2);
+      }
+
+      SECTION("RTCSessionDescriptionInit") {
+        auto maybeInit = node_webrtc::From<node_webrtc::RTCSessionDescriptionInit>(CreateRTCSessionDescriptionInitObject(env).As<Napi::Value>());
+        REQUIRE(maybeInit.IsValid());
+        REQUIRE(maybeInit.UnsafeFromValid().type == node_webrtc::RTCSdpType::kOffer);
+        REQUIRE(maybeInit.UnsafeFromValid().sdp == "v=0\r\n");
+      }
+    }
+
+    SECTION("fails with the same errors as the reference converters for") {
+      SECTION("RTCOnDataEventDict with the wrong sampleRate") {
+        auto object = CreateRTCOnDataEventDictObject(env);
+        object.Set("sampleRate", 44100);
+        Napi::Value value = object;
+        auto maybeDict = node_webrtc::From<node_webrtc::RTCOnDataEventDict>(value);
+        REQUIRE(maybeDict.IsInvalid());
+        REQUIRE(maybeDict.ToErrors() == node_webrtc::ReferenceConverter<Napi::Value, node_webrtc::RTCOnDataEventDict>::Convert(value).ToErrors());
+      }
+
+      SECTION("ImageData without a height") {
+        auto object = CreateImageDataObject(env, 4, 2);
+        object.Delete("height");
+        Napi::Value value = object;
+        auto maybeImageData = node_webrtc::From<node_webrtc::ImageData>(value);
+        REQUIRE(maybeImageData.IsInvalid());
+        REQUIRE(maybeImageData.ToErrors() == node_webrtc::ReferenceConverter<Napi::Value, node_webrtc::ImageData>::Convert(value).ToErrors());
+      }
+
+      SECTION("RTCSessionDescriptionInit with an invalid type") {
+        auto object = CreateRTCSessionDescriptionInitObject(env);
+        object.Set("type", "bogus");
+        Napi::Value value = object;
+        auto maybeInit = node_webrtc::From<node_webrtc::RTCSessionDescriptionInit>(value);
+        REQUIRE(maybeInit.IsInvalid());
+        REQUIRE(maybeInit.ToErrors() == node_webrtc::ReferenceConverter<Napi::Value, node_webrtc::RTCSessionDescriptionInit>::Convert(value).ToErrors());
+      }
+    }
+  }
+}
+
+// Benchmarks are hidden; run them with `npm run test:cpp:benchmark`.
+TEST_CASE("benchmarking hot dictionary conversions", "[.][benchmark]") {
+  auto env = *node_webrtc::Test::env;
+  Napi::HandleScope scope(env);
+  bool valid = true;
+
+  Napi::Value rtcOnDataEventDict = CreateRTCOnDataEventDictObject(env);
+  BENCHMARK("RTCOnDataEventDict (reference)") {
+    auto dict = node_webrtc::ReferenceConverter<Napi::Value, node_webrtc::RTCOnDataEventDict>::Convert(rtcOnDataEventDict);
+    valid &= dict.IsValid();
+    if (dict.IsValid()) {
+      delete[] dict.UnsafeFromValid().samples;
+    }
+  };
+  BENCHMARK("RTCOnDataEventDict (fast path)") {
+    auto dict = node_webrtc::From<node_webrtc::RTCOnDataEventDict>(rtcOnDataEventDict);
+    valid &= dict.IsValid();
+    if (dict.IsValid()) {
+      delete[] dict.UnsafeFromValid().samples;
+    }
+  };
+
+  Napi::Value imageData = CreateImageDataObject(env, 640, 480);
+  BENCHMARK("ImageData (reference)") {
+    valid &= node_webrtc::ReferenceConverter<Napi::Value, node_webrtc::ImageData>::Convert(imageData).IsValid();
+  };
+  BENCHMARK("ImageData (fast path)") {
+    valid &= node_webrtc::From<node_webrtc::ImageData>(imageData).IsValid();
+  };
+  BENCHMARK("I420Buffer (reference)") {
+    valid &= node_webrtc::ReferenceConverter<Napi::Value, node_webrtc::ImageData>::Convert(imageData)
+        .FlatMap<node_webrtc::I420ImageData>([](auto value) { return value.toI420(); })
+        .FlatMap<rtc::scoped_refptr<webrtc::I420Buffer>>(node_webrtc::Converter<node_webrtc::I420ImageData, rtc::scoped_refptr<webrtc::I420Buffer>>::Convert)
+        .IsValid();
+  };
+  BENCHMARK("I420Buffer (fast path)") {
+    valid &= node_webrtc::From<rtc::scoped_refptr<webrtc::I420Buffer>>(imageData).IsValid();
+  };
+
+  Napi::Value rtcSessionDescriptionInit = CreateRTCSessionDescriptionInitObject(env);
+  BENCHMARK("RTCSessionDescriptionInit (reference)") {
+    valid &= node_webrtc::ReferenceConverter<Napi::Value, node_webrtc::RTCSessionDescriptionInit>::Convert(rtcSessionDescriptionInit).IsValid();
+  };
+  BENCHMARK("RTCSessionDescriptionInit (fast path)") {
+    valid &= node_webrtc::From<node_webrtc::RTCSessionDescriptionInit>(rtcSessionDescriptionInit).IsValid();
+  };
+
+  REQUIRE(valid);
+}
+
 Napi::Env* node_webrtc::Test::env = nullptr;
 
 Napi::Value node_webrtc::Test::TestImpl(const Napi::CallbackInfo& info) {
   auto env = info.Env();
   Test::env = &env;
-  auto result = Catch::Session().run();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, maybeArgs, Maybe<std::vector<std::string>>)
+  std::vector<std::string> args = { "wrtc" };
+  auto extraArgs = maybeArgs.FromMaybe(std::vector<std::string>());
+  args.insert(args.end(), extraArgs.begin(), extraArgs.end());
+  std::vector<const char*> argv;
+  for (const auto& arg : args) {
+    argv.push_back(arg.c_str());
+  }
+  auto result = Catch::Session().run(static_cast<int>(argv.size()), argv.data());
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), result, value, Napi::Value)
   return value;
 }
@@ -0,0 +1,594 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/batching_packet_socket_factory.h"
+
+#include <webrtc/rtc_base/async_packet_socket.h>
+#include <webrtc/rtc_base/socket.h>
+#include <webrtc/rtc_base/socket_address.h>
+#include <webrtc/rtc_base/thread.h>
+
+#if defined(WEBRTC_LINUX)
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#include <webrtc/rtc_base/buffer.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/network/sent_packet.h>
+#include <webrtc/rtc_base/physical_socket_server.h>
+#include <webrtc/rtc_base/time_utils.h>
+#include <webrtc/rtc_base/trace_event.h>
+
+// Older C libraries do not define these (see linux/udp.h).
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+#endif  // WEBRTC_LINUX
+
+namespace node_webrtc {
+
+#if defined(WEBRTC_LINUX)
+
+namespace {
+
+// The most messages passed to one recvmmsg or sendmmsg.
+const size_t kBatchSize = 32;
+
+// Like rtc::AsyncUDPSocket, receive datagrams (or GRO buffers) of up to 64 KiB.
+const size_t kMaxDatagramSize = 64 * 1024;
+
+// Each wake-up reads at most this many batches from one socket, so that one
+// busy socket cannot starve the rest of the thread.
+const size_t kMaxReceiveBatches = 4;
+
+// Once this many packets are queued, SendTo fails with EWOULDBLOCK until the
+// queue drains.
+const size_t kMaxQueuedPackets = 256;
+
+// The kernel accepts at most 64 segments, and 64 KiB, per GSO buffer.
+const size_t kMaxSegments = 64;
+const size_t kMaxSegmentedSize = 60 * 1024;
+
+}  // namespace
+
+#endif  // WEBRTC_LINUX
+
+/**
+ * Sockets only read from within PhysicalSocketServer's event loop, and only
+ * prepare sends between a flush's callbacks, so they can all share this.
+ */
+struct BatchBuffers {
+#if defined(WEBRTC_LINUX)
+  BatchBuffers(): receiveData(kBatchSize * kMaxDatagramSize) {}
+
+  std::vector<char> receiveData;
+  mmsghdr receiveMessages[kBatchSize];
+  iovec receiveIovecs[kBatchSize];
+  sockaddr_storage receiveAddresses[kBatchSize];
+  char receiveControl[kBatchSize][CMSG_SPACE(sizeof(int))];
+
+  mmsghdr sendMessages[kBatchSize];
+  iovec sendIovecs[kMaxQueuedPackets];
+  char sendControl[kBatchSize][CMSG_SPACE(sizeof(uint16_t))];
+#endif  // WEBRTC_LINUX
+};
+
+#if defined(WEBRTC_LINUX)
+
+namespace {
+
+/**
+ * A UDP socket that the PhysicalSocketServer polls directly, so that it can
+ * read and write its descriptor with recvmmsg and sendmmsg.
+ */
+class BatchedUdpSocket: public rtc::AsyncPacketSocket, public rtc::Dispatcher {
+ public:
+  static BatchedUdpSocket* Create(
+      rtc::Thread* thread,
+      std::shared_ptr<BatchBuffers> buffers,
+      const rtc::SocketAddress& address,
+      uint16_t minPort,
+      uint16_t maxPort) {
+    auto fd = ::socket(address.family(), SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+      return nullptr;
+    }
+    if (!Bind(fd, address, minPort, maxPort)) {
+      ::close(fd);
+      return nullptr;
+    }
+    return new BatchedUdpSocket(thread, std::move(buffers), fd, address.family());
+  }
+
+  ~BatchedUdpSocket() override {
+    *_alive = false;
+    Close();
+  }
+
+  rtc::SocketAddress GetLocalAddress() const override {
+    return _localAddress;
+  }
+
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return rtc::SocketAddress();
+  }
+
+  int Send(const void*, size_t, const rtc::PacketOptions&) override {
+    _error = ENOTCONN;
+    return -1;
+  }
+
+  int SendTo(const void* data, size_t size, const rtc::SocketAddress& address, const rtc::PacketOptions& options) override {
+    if (_fd < 0) {
+      _error = EBADF;
+      return -1;
+    }
+    if (size > kMaxDatagramSize) {
+      _error = EMSGSIZE;
+      return -1;
+    }
+    if (_queue.size() >= kMaxQueuedPackets) {
+      _error = EWOULDBLOCK;
+      _wouldBlock = true;
+      return -1;
+    }
+
+    _queue.emplace_back();
+    auto& packet = _queue.back();
+    if (!_spare.empty()) {
+      packet.data = std::move(_spare.back());
+      _spare.pop_back();
+    }
+    packet.data.SetData(static_cast<const uint8_t*>(data), size);
+    // Like rtc::PhysicalSocket, send to IPv4 addresses from IPv6 sockets as
+    // IPv4-mapped addresses.
+    packet.addressLength = _family == AF_INET6
+        ? address.ToDualStackSockAddrStorage(&packet.address)
+        : address.ToSockAddrStorage(&packet.address);
+    packet.sentPacket = rtc::SentPacket(options.packet_id, 0, options.info_signaled_after_sent);
+    rtc::CopySocketInformationToPacketInfo(size, *this, true, &packet.sentPacket.info);
+
+    if (_queue.size() >= kBatchSize && !_flushing) {
+      Flush();
+    } else if (!_flushPosted) {
+      // Flush once the current task, which may well send more, is done.
+      _flushPosted = true;
+      auto alive = _alive;
+      _thread->PostTask(RTC_FROM_HERE, [this, alive]() {
+        if (*alive) {
+          _flushPosted = false;
+          Flush();
+        }
+      });
+    }
+    return static_cast<int>(size);
+  }
+
+  int Close() override {
+    if (_fd < 0) {
+      return 0;
+    }
+    _socketServer->Remove(this);
+    ::close(_fd);
+    _fd = -1;
+    _queue.clear();
+    return 0;
+  }
+
+  State GetState() const override {
+    return _fd < 0 ? STATE_CLOSED : STATE_BOUND;
+  }
+
+  int GetOption(rtc::Socket::Option option, int* value) override {
+    int level;
+    int name;
+    if (!TranslateOption(option, &level, &name)) {
+      _error = ENOPROTOOPT;
+      return -1;
+    }
+    socklen_t length = sizeof(*value);
+    if (::getsockopt(_fd, level, name, value, &length) < 0) {
+      _error = errno;
+      return -1;
+    }
+    if (option == rtc::Socket::OPT_DSCP) {
+      *value >>= 2;
+    } else if (option == rtc::Socket::OPT_DONTFRAGMENT) {
+      *value = *value != IP_PMTUDISC_DONT;
+    }
+    return 0;
+  }
+
+  int SetOption(rtc::Socket::Option option, int value) override {
+    int level;
+    int name;
+    if (!TranslateOption(option, &level, &name)) {
+      _error = ENOPROTOOPT;
+      return -1;
+    }
+    if (option == rtc::Socket::OPT_DSCP) {
+      value <<= 2;
+    } else if (option == rtc::Socket::OPT_DONTFRAGMENT) {
+      value = value ? IP_PMTUDISC_DO : IP_PMTUDISC_DONT;
+    }
+    if (::setsockopt(_fd, level, name, &value, sizeof(value)) < 0) {
+      _error = errno;
+      return -1;
+    }
+    return 0;
+  }
+
+  int GetError() const override {
+    return _error;
+  }
+
+  void SetError(int error) override {
+    _error = error;
+  }
+
+  uint32_t GetRequestedEvents() override {
+    return rtc::DE_READ | (_writeBlocked ? rtc::DE_WRITE : 0);
+  }
+
+  void OnEvent(uint32_t ff, int) override {
+    if (ff & (rtc::DE_READ | rtc::DE_CLOSE)) {
+      Receive();
+    }
+    if (_fd >= 0 && (ff & rtc::DE_WRITE)) {
+      SetWriteBlocked(false);
+      Flush();
+    }
+  }
+
+  int GetDescriptor() override {
+    return _fd;
+  }
+
+  bool IsDescriptorClosed() override {
+    return _fd < 0;
+  }
+
+ private:
+  struct Packet {
+    rtc::Buffer data;
+    sockaddr_storage address;
+    size_t addressLength;
+    rtc::SentPacket sentPacket;
+  };
+
+  BatchedUdpSocket(rtc::Thread* thread, std::shared_ptr<BatchBuffers> buffers, int fd, int family)
+    : _thread(thread)
+    // The network thread is created with rtc::Thread::CreateWithSocketServer.
+    , _socketServer(static_cast<rtc::PhysicalSocketServer*>(thread->socketserver()))
+    , _buffers(std::move(buffers))
+    , _fd(fd)
+    , _family(family) {
+    sockaddr_storage address = {};
+    socklen_t length = sizeof(address);
+    if (::getsockname(_fd, reinterpret_cast<sockaddr*>(&address), &length) == 0) {
+      rtc::SocketAddressFromSockAddrStorage(address, &_localAddress);
+    }
+
+    // Probe for UDP GSO, and ask for GRO; kernels before 4.18 and 5.0
+    // respectively support neither.
+    int size = 0;
+    socklen_t sizeLength = sizeof(size);
+    _gso = ::getsockopt(_fd, SOL_UDP, UDP_SEGMENT, &size, &sizeLength) == 0;
+    int one = 1;
+    _gro = ::setsockopt(_fd, SOL_UDP, UDP_GRO, &one, sizeof(one)) == 0;
+
+    _socketServer->Add(this);
+  }
+
+  static bool Bind(int fd, const rtc::SocketAddress& address, uint16_t minPort, uint16_t maxPort) {
+    // Like rtc::BasicPacketSocketFactory, take the first free port in the range.
+    auto bind = [fd](const rtc::SocketAddress& address) {
+      sockaddr_storage storage = {};
+      auto length = address.ToSockAddrStorage(&storage);
+      return ::bind(fd, reinterpret_cast<sockaddr*>(&storage), static_cast<socklen_t>(length)) == 0;
+    };
+    if (minPort == 0 && maxPort == 0) {
+      return bind(address);
+    }
+    for (int port = minPort; port <= maxPort; port++) {
+      if (bind(rtc::SocketAddress(address.ipaddr(), port))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool TranslateOption(rtc::Socket::Option option, int* level, int* name) const {
+    auto ipv6 = _family == AF_INET6;
+    switch (option) {
+      case rtc::Socket::OPT_DONTFRAGMENT:
+        *level = ipv6 ? IPPROTO_IPV6 : IPPROTO_IP;
+        *name = ipv6 ? IPV6_MTU_DISCOVER : IP_MTU_DISCOVER;
+        return true;
+      case rtc::Socket::OPT_RCVBUF:
+        *level = SOL_SOCKET;
+        *name = SO_RCVBUF;
+        return true;
+      case rtc::Socket::OPT_SNDBUF:
+        *level = SOL_SOCKET;
+        *name = SO_SNDBUF;
+        return true;
+      case rtc::Socket::OPT_DSCP:
+        *level = ipv6 ? IPPROTO_IPV6 : IPPROTO_IP;
+        *name = ipv6 ? IPV6_TCLASS : IP_TOS;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  static size_t GroSegmentSize(const msghdr& message) {
+    for (auto cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&message), cmsg)) {
+      if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+        int size;
+        memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+        return size > 0 ? static_cast<size_t>(size) : 0;
+      }
+    }
+    return 0;
+  }
+
+  void Receive() {
+    TRACE_EVENT0("node_webrtc", "BatchedUdpSocket::Receive");
+    auto& buffers = *_buffers;
+    for (size_t batch = 0; batch < kMaxReceiveBatches && _fd >= 0; batch++) {
+      for (size_t i = 0; i < kBatchSize; i++) {
+        auto& iov = buffers.receiveIovecs[i];
+        iov.iov_base = buffers.receiveData.data() + i * kMaxDatagramSize;
+        iov.iov_len = kMaxDatagramSize;
+        auto& header = buffers.receiveMessages[i].msg_hdr;
+        header = {};
+        header.msg_name = &buffers.receiveAddresses[i];
+        header.msg_namelen = sizeof(buffers.receiveAddresses[i]);
+        header.msg_iov = &iov;
+        header.msg_iovlen = 1;
+        header.msg_control = buffers.receiveControl[i];
+        header.msg_controllen = sizeof(buffers.receiveControl[i]);
+      }
+
+      auto received = ::recvmmsg(_fd, buffers.receiveMessages, kBatchSize, MSG_DONTWAIT, nullptr);
+      if (received <= 0) {
+        if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+          _error = errno;
+        }
+        return;
+      }
+
+      auto now = rtc::TimeMicros();
+      for (int i = 0; i < received && _fd >= 0; i++) {
+        rtc::SocketAddress remoteAddress;
+        rtc::SocketAddressFromSockAddrStorage(buffers.receiveAddresses[i], &remoteAddress);
+        auto data = static_cast<const char*>(buffers.receiveIovecs[i].iov_base);
+        size_t length = buffers.receiveMessages[i].msg_len;
+        auto segmentSize = _gro ? GroSegmentSize(buffers.receiveMessages[i].msg_hdr) : 0;
+        if (!segmentSize) {
+          segmentSize = length;
+        }
+        for (size_t offset = 0; offset < length && _fd >= 0; offset += segmentSize) {
+          SignalReadPacket(this, data + offset, std::min(segmentSize, length - offset), remoteAddress, now);
+        }
+      }
+
+      if (static_cast<size_t>(received) < kBatchSize) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * Fill the shared mmsghdrs with up to kBatchSize messages from the front of
+   * the queue, starting at first.
+   * @param segmentCounts set to the number of packets in each message
+   * @return the number of messages
+   */
+  size_t PrepareMessages(size_t first, size_t* segmentCounts) {
+    auto& buffers = *_buffers;
+    size_t messages = 0;
+    size_t next = first;
+    size_t iovecs = 0;
+    while (messages < kBatchSize && next < _queue.size()) {
+      const auto& head = _queue[next];
+      size_t segments = 1;
+      if (_gso) {
+        // Every segment but the last must be exactly as large as the first.
+        auto segmentSize = head.data.size();
+        while (next + segments < _queue.size()
+            && segments < kMaxSegments
+            && (segments + 1) * segmentSize <= kMaxSegmentedSize
+            && _queue[next + segments - 1].data.size() == segmentSize
+            && _queue[next + segments].data.size() <= segmentSize
+            && _queue[next + segments].addressLength == head.addressLength
+            && memcmp(&_queue[next + segments].address, &head.address, head.addressLength) == 0) {
+          segments++;
+        }
+      }
+
+      for (size_t i = 0; i < segments; i++) {
+        auto& data = _queue[next + i].data;
+        buffers.sendIovecs[iovecs + i].iov_base = data.data();
+        buffers.sendIovecs[iovecs + i].iov_len = data.size();
+      }
+
+      auto& header = buffers.sendMessages[messages].msg_hdr;
+      header = {};
+      header.msg_name = const_cast<sockaddr_storage*>(&head.address);
+      header.msg_namelen = static_cast<socklen_t>(head.addressLength);
+      header.msg_iov = &buffers.sendIovecs[iovecs];
+      header.msg_iovlen = segments;
+      if (segments > 1) {
+        header.msg_control = buffers.sendControl[messages];
+        header.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+        auto cmsg = CMSG_FIRSTHDR(&header);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        auto segmentSize = static_cast<uint16_t>(head.data.size());
+        memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+      }
+
+      segmentCounts[messages] = segments;
+      iovecs += segments;
+      next += segments;
+      messages++;
+    }
+    return messages;
+  }
+
+  void Flush() {
+    if (_fd < 0 || _writeBlocked || _flushing || _queue.empty()) {
+      return;
+    }
+    TRACE_EVENT0("node_webrtc", "BatchedUdpSocket::Flush");
+    // SignalSentPacket's handlers may send more, on this socket or others.
+    // Packets this socket queues meanwhile go out in this same loop.
+    _flushing = true;
+    size_t segments[kBatchSize];
+    size_t done = 0;
+    while (done < _queue.size()) {
+      auto messages = PrepareMessages(done, segments);
+      auto sent = ::sendmmsg(_fd, _buffers->sendMessages, static_cast<unsigned int>(messages), MSG_DONTWAIT);
+      auto dropped = false;
+      if (sent < 0) {
+        auto error = errno;
+        if (error == EAGAIN || error == EWOULDBLOCK) {
+          SetWriteBlocked(true);
+          break;
+        }
+        if (error == EIO && segments[0] > 1) {
+          // The device cannot segment; stop asking it to.
+          _gso = false;
+          continue;
+        }
+        // Like a single sendto, fail (and drop) just the first message.
+        _error = error;
+        sent = 1;
+        dropped = true;
+      }
+
+      auto now = rtc::TimeMillis();
+      for (int i = 0; i < sent; i++) {
+        if (dropped) {
+          // Never left, so bandwidth estimation must not count it as sent.
+          done += segments[i];
+          continue;
+        }
+        for (size_t j = 0; j < segments[i]; j++) {
+          auto& packet = _queue[done++];
+          packet.sentPacket.send_time_ms = now;
+          SignalSentPacket(this, packet.sentPacket);
+        }
+      }
+      if (_fd < 0) {
+        _flushing = false;
+        return;
+      }
+    }
+    _flushing = false;
+
+    for (size_t i = 0; i < done; i++) {
+      _spare.push_back(std::move(_queue.front().data));
+      _queue.pop_front();
+    }
+    if (_spare.size() > kBatchSize) {
+      _spare.resize(kBatchSize);
+    }
+
+    if (_wouldBlock && _queue.size() < kMaxQueuedPackets) {
+      _wouldBlock = false;
+      SignalReadyToSend(this);
+    }
+  }
+
+  void SetWriteBlocked(bool writeBlocked) {
+    if (_writeBlocked != writeBlocked) {
+      _writeBlocked = writeBlocked;
+      _socketServer->Update(this);
+    }
+  }
+
+  rtc::Thread* _thread;
+  rtc::PhysicalSocketServer* _socketServer;
+  std::shared_ptr<BatchBuffers> _buffers;
+  int _fd;
+  const int _family;
+  rtc::SocketAddress _localAddress;
+  int _error = 0;
+  bool _gso = false;
+  bool _gro = false;
+
+  std::deque<Packet> _queue;
+  std::vector<rtc::Buffer> _spare;
+  bool _flushPosted = false;
+  bool _flushing = false;
+  bool _writeBlocked = false;  // The kernel's send buffer is full
+  bool _wouldBlock = false;  // SendTo failed because _queue is full
+  std::shared_ptr<bool> _alive = std::make_shared<bool>(true);
+};
+
+}  // namespace
+
+#endif  // WEBRTC_LINUX
+
+BatchingPacketSocketFactory::BatchingPacketSocketFactory(
+    rtc::Thread* thread,
+    bool batch,
+    uint32_t receiveBufferSize,
+    uint32_t sendBufferSize)
+  : rtc::BasicPacketSocketFactory(thread)
+  , _thread(thread)
+  , _batch(batch)
+  , _receiveBufferSize(static_cast<int>(receiveBufferSize))
+  , _sendBufferSize(static_cast<int>(sendBufferSize)) {}
+
+BatchingPacketSocketFactory::~BatchingPacketSocketFactory() = default;
+
+rtc::AsyncPacketSocket* BatchingPacketSocketFactory::CreateUdpSocket(
+    const rtc::SocketAddress& address,
+    uint16_t min_port,
+    uint16_t max_port) {
+  rtc::AsyncPacketSocket* socket = nullptr;
+#if defined(WEBRTC_LINUX)
+  if (_batch) {
+    if (!_buffers) {
+      _buffers = std::make_shared<BatchBuffers>();
+    }
+    socket = BatchedUdpSocket::Create(_thread, _buffers, address, min_port, max_port);
+  }
+#endif  // WEBRTC_LINUX
+  if (!socket) {
+    socket = rtc::BasicPacketSocketFactory::CreateUdpSocket(address, min_port, max_port);
+  }
+  if (socket && _receiveBufferSize) {
+    socket->SetOption(rtc::Socket::OPT_RCVBUF, _receiveBufferSize);
+  }
+  if (socket && _sendBufferSize) {
+    socket->SetOption(rtc::Socket::OPT_SNDBUF, _sendBufferSize);
+  }
+  return socket;
+}
+
+}  // namespace node_webrtc
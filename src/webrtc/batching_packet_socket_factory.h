@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <webrtc/p2p/base/basic_packet_socket_factory.h>
+
+namespace rtc {
+
+class AsyncPacketSocket;
+class SocketAddress;
+class Thread;
+
+}  // namespace rtc
+
+namespace node_webrtc {
+
+struct BatchBuffers;
+
+/**
+ * BatchingPacketSocketFactory creates UDP sockets that move packets in
+ * batches: each wake-up reads every datagram waiting with recvmmsg, and sends
+ * queued during one task on the network thread go out together with sendmmsg
+ * once it finishes. Where the kernel supports them, runs of equal-sized
+ * packets to the same address are sent as one UDP GSO buffer, and UDP GRO
+ * lets one read return several datagrams.
+ *
+ * Batching is Linux-only; elsewhere, or when it is disabled, sockets are
+ * rtc::BasicPacketSocketFactory's. Either way, UDP sockets get the configured
+ * send and receive buffer sizes, where they are non-zero.
+ *
+ * The thread must have been created with rtc::Thread::CreateWithSocketServer.
+ * Like BasicPacketSocketFactory, this must only be used on that thread.
+ */
+class BatchingPacketSocketFactory: public rtc::BasicPacketSocketFactory {
+ public:
+  BatchingPacketSocketFactory(
+      rtc::Thread* thread,
+      bool batch,
+      uint32_t receiveBufferSize,
+      uint32_t sendBufferSize);
+
+  ~BatchingPacketSocketFactory() override;
+
+  rtc::AsyncPacketSocket* CreateUdpSocket(
+      const rtc::SocketAddress& address,
+      uint16_t min_port,
+      uint16_t max_port) override;
+
+ private:
+  rtc::Thread* _thread;
+  const bool _batch;
+  const int _receiveBufferSize;
+  const int _sendBufferSize;
+  // Scratch space shared by every batched socket; created on first use.
+  std::shared_ptr<BatchBuffers> _buffers;
+};
+
+}  // namespace node_webrtc
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/caching_network_manager.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <webrtc/rtc_base/ip_address.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
+
+namespace node_webrtc {
+
+CachingNetworkManager::CachingNetworkManager(std::vector<std::string> allowList, bool cache)
+  : _allowList(std::move(allowList))
+  , _cache(cache) {
+  _networkManager.SignalNetworksChanged.connect(this, &CachingNetworkManager::OnNetworksChanged);
+}
+
+void CachingNetworkManager::StartUpdating() {
+  _startCount++;
+  if (_enumerated) {
+    // Each allocator session waits for SignalNetworksChanged after starting us,
+    // just as it would with a BasicNetworkManager that is already running.
+    rtc::Thread::Current()->Post(RTC_FROM_HERE, this, kSignalNetworks);
+  }
+  if (!_enumerating && !(_cache && _enumerated)) {
+    _enumerating = true;
+    _networkManager.StartUpdating();
+  }
+}
+
+void CachingNetworkManager::StopUpdating() {
+  if (!_startCount) {
+    return;
+  }
+  if (!--_startCount && _enumerating) {
+    _enumerating = false;
+    _networkManager.StopUpdating();
+  }
+}
+
+void CachingNetworkManager::OnMessage(rtc::Message* message) {
+  switch (message->message_id) {
+    case kSignalNetworks:
+      SignalNetworksChanged();
+      break;
+    case kStopEnumerating:
+      if (_enumerating) {
+        _enumerating = false;
+        _networkManager.StopUpdating();
+      }
+      break;
+  }
+}
+
+void CachingNetworkManager::OnNetworksChanged() {
+  NetworkList networks;
+  _networkManager.GetNetworks(&networks);
+
+  NetworkList allowed;
+  for (auto network : networks) {
+    auto copy = Filter(*network);
+    if (copy) {
+      allowed.push_back(copy);
+    }
+  }
+
+  // MergeNetworkList takes ownership of the copies.
+  bool changed = false;
+  MergeNetworkList(allowed, &changed);
+
+  rtc::IPAddress ipv4;
+  rtc::IPAddress ipv6;
+  _networkManager.GetDefaultLocalAddress(AF_INET, &ipv4);
+  _networkManager.GetDefaultLocalAddress(AF_INET6, &ipv6);
+  set_default_local_addresses(ipv4, ipv6);
+
+  if (changed || !_enumerated) {
+    _enumerated = true;
+    SignalNetworksChanged();
+  }
+
+  if (_cache && _enumerating) {
+    // The BasicNetworkManager schedules its next enumeration after signalling,
+    // so stop it once it has done so.
+    rtc::Thread::Current()->Post(RTC_FROM_HERE, this, kStopEnumerating);
+  }
+}
+
+rtc::Network* CachingNetworkManager::Filter(const rtc::Network& network) const {
+  auto copy = std::make_unique<rtc::Network>(network);
+  if (_allowList.empty() || IsAllowed(network.name())) {
+    return copy.release();
+  }
+
+  std::vector<rtc::InterfaceAddress> ips;
+  for (const auto& ip : network.GetIPs()) {
+    if (IsAllowed(ip.ToString())) {
+      ips.push_back(ip);
+    }
+  }
+  if (ips.empty()) {
+    return nullptr;
+  }
+  bool changed = false;
+  copy->SetIPs(ips, &changed);
+  return copy.release();
+}
+
+bool CachingNetworkManager::IsAllowed(const std::string& nameOrAddress) const {
+  return std::find(_allowList.begin(), _allowList.end(), nameOrAddress) != _allowList.end();
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <webrtc/rtc_base/message_handler.h>
+#include <webrtc/rtc_base/network.h>
+#include <webrtc/rtc_base/third_party/sigslot/sigslot.h>
+
+namespace rtc { class Message; }
+
+namespace node_webrtc {
+
+/**
+ * CachingNetworkManager wraps an rtc::BasicNetworkManager that every
+ * BasicPortAllocator of a PeerConnectionFactory shares.
+ *
+ * With an allow-list, only the listed networks are reported: an entry matches
+ * either an interface name (keeping all of its addresses) or an IP address
+ * (keeping just that address).
+ *
+ * With caching, networks are enumerated once. Later allocator sessions get the
+ * cached result straight away, and the BasicNetworkManager does not re-enumerate
+ * every two seconds while sessions are gathering.
+ *
+ * Like any NetworkManager, it must only be used on the network thread.
+ */
+class CachingNetworkManager
+  : public rtc::NetworkManagerBase
+  , public rtc::MessageHandlerAutoCleanup
+  , public sigslot::has_slots<> {
+ public:
+  CachingNetworkManager(std::vector<std::string> allowList, bool cache);
+
+  void StartUpdating() override;
+  void StopUpdating() override;
+
+  void OnMessage(rtc::Message*) override;
+
+ private:
+  enum Message {
+    kSignalNetworks,
+    kStopEnumerating
+  };
+
+  void OnNetworksChanged();
+  rtc::Network* Filter(const rtc::Network&) const;
+  bool IsAllowed(const std::string&) const;
+
+  rtc::BasicNetworkManager _networkManager;
+  const std::vector<std::string> _allowList;
+  const bool _cache;
+  int _startCount = 0;
+  bool _enumerating = false;
+  bool _enumerated = false;
+};
+
+}  // namespace node_webrtc
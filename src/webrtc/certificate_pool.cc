@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/certificate_pool.h"
+
+#include <cassert>
+#include <utility>
+
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/rtc_certificate_generator.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/time_utils.h>
+#include <webrtc/rtc_base/trace_event.h>
+
+namespace node_webrtc {
+
+CertificatePool* CertificatePool::Get() {
+  // Leaked on purpose: connections on libwebrtc's threads may take from the
+  // pool during shutdown.
+  static auto pool = new CertificatePool();
+  return pool;
+}
+
+rtc::Thread* CertificatePool::thread() {
+  if (!_thread) {
+    _thread = rtc::Thread::Create();
+    assert(_thread);
+    _thread->SetName("certificates", nullptr);
+    _thread->Start();
+  }
+  return _thread.get();
+}
+
+void CertificatePool::Generate(
+    const rtc::KeyParams& params,
+    const absl::optional<uint64_t>& expiresMs,
+    Callback callback) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  thread()->PostTask(RTC_FROM_HERE, [params, expiresMs, callback]() {
+    TRACE_EVENT0("node_webrtc", "CertificatePool::Generate");
+    callback(rtc::RTCCertificateGenerator::GenerateCertificate(params, expiresMs));
+  });
+}
+
+void CertificatePool::SetSize(size_t size) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _size = size;
+  while (_certificates.size() > _size) {
+    _certificates.pop_back();
+  }
+  Refill();
+}
+
+rtc::scoped_refptr<rtc::RTCCertificate> CertificatePool::Take() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_size) {
+    return nullptr;
+  }
+
+  auto now = static_cast<uint64_t>(rtc::TimeUTCMillis());
+  while (!_certificates.empty() && _certificates.front()->HasExpired(now)) {
+    _certificates.pop_front();
+  }
+
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate;
+  if (_certificates.empty()) {
+    _misses++;
+  } else {
+    _hits++;
+    certificate = std::move(_certificates.front());
+    _certificates.pop_front();
+  }
+  Refill();
+  return certificate;
+}
+
+CertificatePool::Stats CertificatePool::stats() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return {_size, _certificates.size(), _hits, _misses};
+}
+
+void CertificatePool::Refill() {
+  // Called with _mutex held.
+  while (_certificates.size() + _generating < _size) {
+    _generating++;
+    thread()->PostTask(RTC_FROM_HERE, [this]() {
+      TRACE_EVENT0("node_webrtc", "CertificatePool::Refill");
+      DidGenerate(rtc::RTCCertificateGenerator::GenerateCertificate(
+          rtc::KeyParams::ECDSA(rtc::EC_NIST_P256), absl::nullopt));
+    });
+  }
+}
+
+void CertificatePool::DidGenerate(rtc::scoped_refptr<rtc::RTCCertificate> certificate) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _generating--;
+  // If generation failed, wait for the next Take to try again, rather than
+  // spinning here.
+  if (certificate && _certificates.size() < _size) {
+    _certificates.push_back(std::move(certificate));
+  }
+}
+
+}  // namespace node_webrtc
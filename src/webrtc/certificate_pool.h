@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <absl/types/optional.h>
+#include <webrtc/api/scoped_refptr.h>
+#include <webrtc/rtc_base/rtc_certificate.h>
+#include <webrtc/rtc_base/ssl_identity.h>
+
+namespace rtc { class Thread; }
+
+namespace node_webrtc {
+
+/**
+ * CertificatePool generates DTLS certificates on its own thread, so that
+ * neither JavaScript nor connection setup waits for key generation.
+ *
+ * Optionally, it keeps a number of ECDSA P-256 certificates (libwebrtc's
+ * default) ready ahead of time. An RTCPeerConnection created without
+ * `certificates` takes one of these instead of generating its own, and the
+ * pool starts generating a replacement. The pool is empty until a size is set.
+ *
+ * Everything here is thread-safe.
+ */
+class CertificatePool {
+ public:
+  using Callback = std::function<void(rtc::scoped_refptr<rtc::RTCCertificate>)>;
+
+  struct Stats {
+    size_t size;
+    size_t available;
+    uint64_t hits;
+    uint64_t misses;
+  };
+
+  /**
+   * The process-wide CertificatePool.
+   */
+  static CertificatePool* Get();
+
+  /**
+   * Generate a certificate on the pool's thread.
+   * @param callback invoked on the pool's thread with the certificate, or with
+   * nullptr if generation failed
+   */
+  void Generate(const rtc::KeyParams&, const absl::optional<uint64_t>& expiresMs, Callback callback);
+
+  /**
+   * Keep up to size certificates ready. Zero disables the pool and releases
+   * every pooled certificate.
+   */
+  void SetSize(size_t size);
+
+  /**
+   * Take a pooled certificate and start generating its replacement.
+   * @return a certificate, or nullptr if none is ready
+   */
+  rtc::scoped_refptr<rtc::RTCCertificate> Take();
+
+  Stats stats();
+
+ private:
+  CertificatePool() = default;
+
+  rtc::Thread* thread();
+  void Refill();
+  void DidGenerate(rtc::scoped_refptr<rtc::RTCCertificate>);
+
+  std::mutex _mutex{};
+  std::unique_ptr<rtc::Thread> _thread;  // Guarded by _mutex; started on first use
+  std::deque<rtc::scoped_refptr<rtc::RTCCertificate>> _certificates;  // Guarded by _mutex
+  size_t _size = 0;  // Guarded by _mutex
+  size_t _generating = 0;  // Guarded by _mutex
+  uint64_t _hits = 0;  // Guarded by _mutex
+  uint64_t _misses = 0;  // Guarded by _mutex
+};
+
+}  // namespace node_webrtc
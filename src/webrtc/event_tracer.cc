@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/event_tracer.h"
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#if defined(WEBRTC_POSIX)
+#include <pthread.h>
+#endif
+
+#include <uv.h>
+#include <webrtc/rtc_base/event_tracer.h>
+#include <webrtc/rtc_base/platform_thread_types.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/time_utils.h>
+#include <webrtc/rtc_base/trace_event.h>
+
+namespace node_webrtc {
+
+namespace {
+
+/**
+ * TRACE_EVENT sites hold a pointer to their category's `enabled` flag, which
+ * is also how AddTraceEvent finds the category's name again.
+ */
+struct Category {
+  unsigned char enabled;
+  const char* name;
+};
+
+const unsigned char kAlwaysDisabled = 0;
+
+const char kDisabledByDefaultPrefix[] = "disabled-by-default-";
+
+struct State {
+  std::mutex mutex;
+  std::unordered_map<std::string, Category*> categories;  // Leaked
+  FILE* file = nullptr;
+  bool first = true;
+  uint64_t generation = 0;
+  uint64_t pid = 0;
+};
+
+State& GetState() {
+  // Leaked on purpose, since libwebrtc threads may still trace during exit.
+  static auto state = new State();
+  return *state;
+}
+
+void AppendEscaped(std::ostringstream& json, const char* string) {
+  json << '"';
+  for (auto c = string; *c; c++) {
+    switch (*c) {
+      case '"': json << "\\\""; break;
+      case '\\': json << "\\\\"; break;
+      case '\n': json << "\\n"; break;
+      case '\r': json << "\\r"; break;
+      case '\t': json << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+          json << escaped;
+        } else {
+          json << *c;
+        }
+    }
+  }
+  json << '"';
+}
+
+void AppendArgValue(std::ostringstream& json, unsigned char type, unsigned long long value) {  // NOLINT
+  switch (type) {
+    case TRACE_VALUE_TYPE_BOOL:
+      json << (value ? "true" : "false");
+      break;
+    case TRACE_VALUE_TYPE_UINT:
+      json << value;
+      break;
+    case TRACE_VALUE_TYPE_INT:
+      json << static_cast<long long>(value);  // NOLINT
+      break;
+    case TRACE_VALUE_TYPE_DOUBLE: {
+      double number;
+      std::memcpy(&number, &value, sizeof(number));
+      json << number;
+      break;
+    }
+    case TRACE_VALUE_TYPE_POINTER: {
+      char pointer[24];
+      snprintf(pointer, sizeof(pointer), "\"0x%" PRIx64 "\"", static_cast<uint64_t>(value));
+      json << pointer;
+      break;
+    }
+    case TRACE_VALUE_TYPE_STRING:
+    case TRACE_VALUE_TYPE_COPY_STRING: {
+      auto string = reinterpret_cast<const char*>(static_cast<uintptr_t>(value));
+      AppendEscaped(json, string ? string : "");
+      break;
+    }
+    default:
+      json << "null";
+  }
+}
+
+std::string CurrentThreadName() {
+  auto thread = rtc::Thread::Current();
+  if (thread && !thread->name().empty()) {
+    return thread->name();
+  }
+#if defined(WEBRTC_POSIX)
+  char name[64] = {};
+  if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0 && name[0]) {
+    return name;
+  }
+#endif
+  return "";
+}
+
+// Must be called with the State's mutex held.
+void Write(State& state, const std::string& record) {
+  if (!state.first) {
+    std::fputs(",\n", state.file);
+  }
+  std::fputs(record.c_str(), state.file);
+  state.first = false;
+}
+
+const unsigned char* GetCategoryEnabled(const char* name) {
+  if (std::strncmp(name, kDisabledByDefaultPrefix, sizeof(kDisabledByDefaultPrefix) - 1) == 0) {
+    return &kAlwaysDisabled;
+  }
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  auto& category = state.categories[name];
+  if (!category) {
+    auto copy = new char[std::strlen(name) + 1];
+    std::strcpy(copy, name);  // NOLINT
+    category = new Category{ static_cast<unsigned char>(state.file ? 1 : 0), copy };
+  }
+  return &category->enabled;
+}
+
+void AddTraceEvent(
+    char phase,
+    const unsigned char* category_enabled,
+    const char* name,
+    unsigned long long id,  // NOLINT
+    int num_args,
+    const char** arg_names,
+    const unsigned char* arg_types,
+    const unsigned long long* arg_values,  // NOLINT
+    unsigned char flags) {
+  if (!*category_enabled) {
+    return;
+  }
+  auto category = reinterpret_cast<const Category*>(category_enabled);
+  auto timestamp = rtc::TimeMicros();
+  auto tid = static_cast<uint64_t>(rtc::CurrentThreadId());
+
+  std::ostringstream json;
+  json << "{\"ph\":\"" << phase << "\",\"cat\":";
+  AppendEscaped(json, category->name);
+  json << ",\"name\":";
+  AppendEscaped(json, name);
+  json << ",\"ts\":" << timestamp;
+  if (flags & TRACE_EVENT_FLAG_HAS_ID) {
+    json << ",\"id\":\"0x" << std::hex << id << std::dec << '"';
+  }
+  json << ",\"args\":{";
+  for (int i = 0; i < num_args; i++) {
+    json << (i ? "," : "");
+    AppendEscaped(json, arg_names[i]);
+    json << ':';
+    AppendArgValue(json, arg_types[i], arg_values[i]);
+  }
+  json << "}";
+
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (!state.file) {
+    return;
+  }
+  json << ",\"pid\":" << state.pid << ",\"tid\":" << tid << "}";
+
+  // Name each thread once per capture.
+  static thread_local uint64_t namedInGeneration = 0;
+  auto threadName = namedInGeneration != state.generation ? CurrentThreadName() : "";
+  namedInGeneration = state.generation;
+  if (!threadName.empty()) {
+    std::ostringstream metadata;
+    metadata << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << state.pid << ",\"tid\":" << tid
+        << ",\"args\":{\"name\":";
+    AppendEscaped(metadata, threadName.c_str());
+    metadata << "}}";
+    Write(state, metadata.str());
+  }
+  Write(state, json.str());
+}
+
+}  // namespace
+
+void EventTracer::Install() {
+  static std::once_flag once;
+  std::call_once(once, []() {
+    webrtc::SetupEventTracer(GetCategoryEnabled, AddTraceEvent);
+  });
+}
+
+bool EventTracer::Start(const std::string& path) {
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (state.file) {
+    return false;
+  }
+  state.file = std::fopen(path.c_str(), "w");
+  if (!state.file) {
+    return false;
+  }
+  std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", state.file);
+  state.first = true;
+  state.generation++;
+  state.pid = static_cast<uint64_t>(uv_os_getpid());
+  for (auto& category : state.categories) {
+    category.second->enabled = 1;
+  }
+  return true;
+}
+
+void EventTracer::Stop() {
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (!state.file) {
+    return;
+  }
+  for (auto& category : state.categories) {
+    category.second->enabled = 0;
+  }
+  std::fputs("\n]}\n", state.file);
+  std::fclose(state.file);
+  state.file = nullptr;
+}
+
+bool EventTracer::IsTracing() {
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.file != nullptr;
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <string>
+
+namespace node_webrtc {
+
+/**
+ * EventTracer records libwebrtc's TRACE_EVENTs, along with our own (in the
+ * "node_webrtc" category), and writes them to a file in the Chrome trace-event
+ * JSON format, which chrome://tracing and ui.perfetto.dev can open.
+ *
+ * Each TRACE_EVENT site looks up its category's enabled flag the first time
+ * it runs and then only reads that flag, so Install must be called before any
+ * TRACE_EVENT runs. While tracing is stopped every flag is zero, and a
+ * TRACE_EVENT costs a load and a branch.
+ */
+class EventTracer {
+ public:
+  /**
+   * Install EventTracer as libwebrtc's event tracer. Safe to call more than
+   * once.
+   */
+  static void Install();
+
+  /**
+   * Start writing trace events to a file, replacing its contents.
+   * @param path the file to write to
+   * @return false if already tracing, or if the file cannot be opened
+   */
+  static bool Start(const std::string& path);
+
+  /**
+   * Stop tracing and finish writing the file. Does nothing if not tracing.
+   */
+  static void Stop();
+
+  static bool IsTracing();
+};
+
+}  // namespace node_webrtc
@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/in_process_network.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+#include <webrtc/rtc_base/async_packet_socket.h>
+#include <webrtc/rtc_base/copy_on_write_buffer.h>
+#include <webrtc/rtc_base/ip_address.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/network/sent_packet.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/time_utils.h>
+
+namespace node_webrtc {
+
+namespace {
+
+enum Message {
+  kSignalNetworks
+};
+
+}  // namespace
+
+void InProcessNetworkManager::StartUpdating() {
+  _startCount++;
+  if (!_merged) {
+    _merged = true;
+    rtc::IPAddress address(kAddress);
+    // MergeNetworkList takes ownership of the network.
+    auto network = new rtc::Network("in-process", "In-process network", rtc::IPAddress(kAddress & 0xff000000), 8,
+        rtc::ADAPTER_TYPE_ETHERNET);
+    network->AddIP(rtc::InterfaceAddress(address));
+    bool changed = false;
+    MergeNetworkList(NetworkList({network}), &changed);
+    set_default_local_addresses(address, rtc::IPAddress());
+  }
+  // Each allocator session waits for SignalNetworksChanged after starting us.
+  rtc::Thread::Current()->Post(RTC_FROM_HERE, this, kSignalNetworks);
+}
+
+void InProcessNetworkManager::StopUpdating() {
+  if (_startCount) {
+    _startCount--;
+  }
+}
+
+void InProcessNetworkManager::OnMessage(rtc::Message* message) {
+  if (message->message_id == kSignalNetworks) {
+    SignalNetworksChanged();
+  }
+}
+
+/**
+ * A UDP socket bound to an address of an InProcessPacketSocketFactory.
+ */
+class InProcessUdpSocket: public rtc::AsyncPacketSocket {
+ public:
+  explicit InProcessUdpSocket(InProcessPacketSocketFactory* factory): _factory(factory) {}
+
+  ~InProcessUdpSocket() override {
+    Close();
+  }
+
+  rtc::SocketAddress GetLocalAddress() const override {
+    return _address;
+  }
+
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return rtc::SocketAddress();
+  }
+
+  int Send(const void*, size_t, const rtc::PacketOptions&) override {
+    _error = ENOTCONN;
+    return -1;
+  }
+
+  int SendTo(const void* data, size_t size, const rtc::SocketAddress& address, const rtc::PacketOptions& options) override {
+    if (!_factory) {
+      _error = EBADF;
+      return -1;
+    }
+    rtc::SentPacket sentPacket(options.packet_id, rtc::TimeMillis(), options.info_signaled_after_sent);
+    rtc::CopySocketInformationToPacketInfo(size, *this, true, &sentPacket.info);
+    _factory->Send(&_link, data, size, _address, address);
+    SignalSentPacket(this, sentPacket);
+    return static_cast<int>(size);
+  }
+
+  int Close() override {
+    if (_factory) {
+      _factory->Unbind(_address);
+      _factory = nullptr;
+    }
+    return 0;
+  }
+
+  State GetState() const override {
+    return _factory ? STATE_BOUND : STATE_CLOSED;
+  }
+
+  int GetOption(rtc::Socket::Option option, int* value) override {
+    auto it = _options.find(option);
+    if (it == _options.end()) {
+      _error = ENOPROTOOPT;
+      return -1;
+    }
+    *value = it->second;
+    return 0;
+  }
+
+  int SetOption(rtc::Socket::Option option, int value) override {
+    // Options have no effect on the in-process network, but remember them.
+    _options[option] = value;
+    return 0;
+  }
+
+  int GetError() const override {
+    return _error;
+  }
+
+  void SetError(int error) override {
+    _error = error;
+  }
+
+  void Deliver(const char* data, size_t size, const rtc::SocketAddress& from) {
+    SignalReadPacket(this, data, size, from, rtc::TimeMicros());
+  }
+
+  /**
+   * The factory is going away before the socket.
+   */
+  void Detach() {
+    _factory = nullptr;
+  }
+
+ private:
+  friend class InProcessPacketSocketFactory;
+
+  InProcessPacketSocketFactory* _factory;
+  rtc::SocketAddress _address;
+  InProcessPacketSocketFactory::Link _link;
+  std::map<rtc::Socket::Option, int> _options;
+  int _error = 0;
+};
+
+InProcessPacketSocketFactory::InProcessPacketSocketFactory(rtc::Thread* thread, const NetworkConditions& conditions)
+  : rtc::BasicPacketSocketFactory(thread)
+  , _thread(thread)
+  , _conditions(conditions)
+  , _random(1) {}
+
+InProcessPacketSocketFactory::~InProcessPacketSocketFactory() {
+  *_alive = false;
+  for (auto& entry : _sockets) {
+    entry.second->Detach();
+  }
+}
+
+rtc::AsyncPacketSocket* InProcessPacketSocketFactory::CreateUdpSocket(
+    const rtc::SocketAddress& address,
+    uint16_t min_port,
+    uint16_t max_port) {
+  auto socket = std::unique_ptr<InProcessUdpSocket>(new InProcessUdpSocket(this));
+  if (!Bind(socket.get(), address, min_port, max_port, &socket->_address)) {
+    socket->Detach();
+    return nullptr;
+  }
+  return socket.release();
+}
+
+bool InProcessPacketSocketFactory::Bind(
+    InProcessUdpSocket* socket,
+    const rtc::SocketAddress& address,
+    uint16_t minPort,
+    uint16_t maxPort,
+    rtc::SocketAddress* bound) {
+  auto tryBind = [this, socket, &address, bound](uint16_t port) {
+    rtc::SocketAddress candidate(address.ipaddr(), port);
+    if (!port || _sockets.count(candidate)) {
+      return false;
+    }
+    _sockets[candidate] = socket;
+    *bound = candidate;
+    return true;
+  };
+
+  if (address.port()) {
+    return tryBind(address.port());
+  }
+  if (minPort || maxPort) {
+    for (int port = minPort; port <= maxPort; port++) {
+      if (tryBind(static_cast<uint16_t>(port))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  // Like the kernel, hand out ephemeral ports round-robin.
+  for (int i = 0; i < 16384; i++) {
+    auto port = _nextPort;
+    _nextPort = _nextPort == 65535 ? 49152 : _nextPort + 1;
+    if (tryBind(port)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void InProcessPacketSocketFactory::Unbind(const rtc::SocketAddress& address) {
+  _sockets.erase(address);
+}
+
+void InProcessPacketSocketFactory::Send(
+    Link* link,
+    const void* data,
+    size_t size,
+    const rtc::SocketAddress& from,
+    const rtc::SocketAddress& to) {
+  auto now = rtc::TimeMicros();
+  while (!link->departuresUs.empty() && link->departuresUs.front() <= now) {
+    link->departuresUs.pop_front();
+  }
+
+  if (_conditions.queueLength && link->departuresUs.size() >= _conditions.queueLength) {
+    return;
+  }
+  if (_conditions.loss > 0 && std::uniform_real_distribution<double>(0, 1)(_random) < _conditions.loss) {
+    return;
+  }
+
+  auto departure = std::max(now, link->nextDepartureUs);
+  if (_conditions.bandwidth > 0) {
+    departure += static_cast<int64_t>(size * 8 * 1e6 / _conditions.bandwidth);
+    link->nextDepartureUs = departure;
+    link->departuresUs.push_back(departure);
+  }
+
+  auto delayMs = _conditions.delay;
+  if (_conditions.jitter > 0) {
+    delayMs += std::normal_distribution<double>(0, _conditions.jitter)(_random);
+  }
+  auto arrival = std::max(departure + static_cast<int64_t>(std::max(delayMs, 0.0) * 1000), link->lastArrivalUs);
+  link->lastArrivalUs = arrival;
+
+  auto alive = _alive;
+  auto deliver = [this, alive, from, to, buffer = rtc::CopyOnWriteBuffer(static_cast<const uint8_t*>(data), size)]() {
+    if (*alive) {
+      Deliver(from, to, buffer.cdata<char>(), buffer.size());
+    }
+  };
+  // The thread's timers have millisecond resolution; round up, so that
+  // arrivals keep their order.
+  auto waitMs = (arrival - now + 999) / 1000;
+  if (waitMs > 0) {
+    _thread->PostDelayedTask(RTC_FROM_HERE, std::move(deliver), static_cast<uint32_t>(waitMs));
+  } else {
+    _thread->PostTask(RTC_FROM_HERE, std::move(deliver));
+  }
+}
+
+void InProcessPacketSocketFactory::Deliver(
+    const rtc::SocketAddress& from,
+    const rtc::SocketAddress& to,
+    const char* data,
+    size_t size) {
+  auto it = _sockets.find(to);
+  if (it != _sockets.end()) {
+    it->second->Deliver(data, size, from);
+  }
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <random>
+
+#include <webrtc/p2p/base/basic_packet_socket_factory.h>
+#include <webrtc/rtc_base/message_handler.h>
+#include <webrtc/rtc_base/network.h>
+#include <webrtc/rtc_base/socket_address.h>
+
+#include "src/dictionaries/node_webrtc/network_conditions.h"
+
+namespace rtc {
+
+class AsyncPacketSocket;
+class Message;
+class Thread;
+
+}  // namespace rtc
+
+namespace node_webrtc {
+
+class InProcessUdpSocket;
+
+/**
+ * InProcessNetworkManager reports a single network, "in-process", whose only
+ * address is kAddress. Together with InProcessPacketSocketFactory, it keeps
+ * every RTCPeerConnection of a PeerConnectionFactory off the kernel's network
+ * stack.
+ *
+ * Like any NetworkManager, it must only be used on the network thread.
+ */
+class InProcessNetworkManager
+  : public rtc::NetworkManagerBase
+  , public rtc::MessageHandlerAutoCleanup {
+ public:
+  static const uint32_t kAddress = 0x0a000001;  // 10.0.0.1
+
+  void StartUpdating() override;
+  void StopUpdating() override;
+
+  void OnMessage(rtc::Message*) override;
+
+ private:
+  int _startCount = 0;
+  bool _merged = false;
+};
+
+/**
+ * InProcessPacketSocketFactory creates UDP sockets that exchange packets
+ * through memory on the network thread, rather than through the kernel. A
+ * packet sent to an address that no socket is bound to is dropped. TCP is
+ * not emulated, so PeerConnectionFactory disables TCP candidates.
+ *
+ * Each socket sends over a link of its own with the factory's
+ * NetworkConditions, modelled like libwebrtc's SimulatedNetwork: packets queue
+ * for the link's bandwidth, may be dropped at random or when the queue is
+ * full, and then arrive after the delay plus normally distributed jitter,
+ * never overtaking the packet before. The random numbers come from a fixed
+ * seed, so a run that sends the same packets sees the same losses.
+ *
+ * Like BasicPacketSocketFactory, it must only be used on the network thread.
+ */
+class InProcessPacketSocketFactory: public rtc::BasicPacketSocketFactory {
+ public:
+  InProcessPacketSocketFactory(rtc::Thread* thread, const NetworkConditions& conditions);
+
+  ~InProcessPacketSocketFactory() override;
+
+  rtc::AsyncPacketSocket* CreateUdpSocket(
+      const rtc::SocketAddress& address,
+      uint16_t min_port,
+      uint16_t max_port) override;
+
+ private:
+  friend class InProcessUdpSocket;
+
+  struct Link {
+    int64_t nextDepartureUs = 0;
+    int64_t lastArrivalUs = 0;
+    std::deque<int64_t> departuresUs;
+  };
+
+  bool Bind(InProcessUdpSocket*, const rtc::SocketAddress&, uint16_t minPort, uint16_t maxPort, rtc::SocketAddress* bound);
+  void Unbind(const rtc::SocketAddress&);
+  void Send(Link*, const void* data, size_t size, const rtc::SocketAddress& from, const rtc::SocketAddress& to);
+  void Deliver(const rtc::SocketAddress& from, const rtc::SocketAddress& to, const char* data, size_t size);
+
+  rtc::Thread* _thread;
+  const NetworkConditions _conditions;
+  std::map<rtc::SocketAddress, InProcessUdpSocket*> _sockets;
+  uint16_t _nextPort = 49152;
+  std::mt19937 _random;
+  // Deliveries run on the network thread, which is where this is destroyed too.
+  std::shared_ptr<bool> _alive = std::make_shared<bool>(true);
+};
+
+}  // namespace node_webrtc
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/port_allocator_pool.h"
+
+#include <utility>
+
+#include <webrtc/api/rtc_error.h>
+#include <webrtc/p2p/client/basic_port_allocator.h>
+#include <webrtc/pc/ice_server_parsing.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/trace_event.h>
+
+namespace node_webrtc {
+
+/**
+ * The flags PeerConnection gives its allocator's sessions, starting from
+ * flags (see PeerConnection::InitializePortAllocator_n).
+ */
+static int SessionFlags(const webrtc::PeerConnectionInterface::RTCConfiguration& configuration, uint32_t flags) {
+  int sessionFlags = static_cast<int>(flags)
+      | cricket::PORTALLOCATOR_ENABLE_SHARED_SOCKET
+      | cricket::PORTALLOCATOR_ENABLE_IPV6
+      | cricket::PORTALLOCATOR_ENABLE_IPV6_ON_WIFI;
+  if (configuration.disable_ipv6) {
+    sessionFlags &= ~cricket::PORTALLOCATOR_ENABLE_IPV6;
+  }
+  if (configuration.disable_ipv6_on_wifi) {
+    sessionFlags &= ~cricket::PORTALLOCATOR_ENABLE_IPV6_ON_WIFI;
+  }
+  if (configuration.tcp_candidate_policy == webrtc::PeerConnectionInterface::kTcpCandidatePolicyDisabled) {
+    sessionFlags |= cricket::PORTALLOCATOR_DISABLE_TCP;
+  }
+  if (configuration.candidate_network_policy == webrtc::PeerConnectionInterface::kCandidateNetworkPolicyLowCost) {
+    sessionFlags |= cricket::PORTALLOCATOR_DISABLE_COSTLY_NETWORKS;
+  }
+  if (configuration.disable_link_local_networks) {
+    sessionFlags |= cricket::PORTALLOCATOR_DISABLE_LINK_LOCAL_NETWORKS;
+  }
+  return sessionFlags;
+}
+
+PortAllocatorPool::PortAllocatorPool(
+    rtc::Thread* networkThread,
+    rtc::NetworkManager* networkManager,
+    rtc::PacketSocketFactory* socketFactory,
+    size_t size,
+    const webrtc::PeerConnectionInterface::IceServers& iceServers,
+    const UnsignedShortRange& portRange,
+    uint32_t flags)
+  : _networkThread(networkThread)
+  , _networkManager(networkManager)
+  , _socketFactory(socketFactory)
+  , _size(size)
+  , _iceServers(iceServers)
+  , _minPort(portRange.min.FromMaybe(0))
+  , _maxPort(portRange.max.FromMaybe(65535))
+  , _flags(SessionFlags(webrtc::PeerConnectionInterface::RTCConfiguration(), flags)) {
+  // Parse the servers the way PeerConnection will, so that its allocator
+  // keeps the pooled session rather than discarding it for new servers.
+  _valid = webrtc::ParseIceServers(_iceServers, &_stunServers, &_turnServers) == webrtc::RTCErrorType::NONE;
+  std::lock_guard<std::mutex> lock(_mutex);
+  Refill();
+}
+
+PortAllocatorPool::~PortAllocatorPool() {
+  *_alive = false;
+}
+
+std::unique_ptr<cricket::PortAllocator> PortAllocatorPool::Take(
+    const webrtc::PeerConnectionInterface::RTCConfiguration& configuration,
+    const UnsignedShortRange& portRange,
+    uint32_t flags) {
+  if (configuration.servers != _iceServers
+      || portRange.min.FromMaybe(0) != _minPort
+      || portRange.max.FromMaybe(65535) != _maxPort
+      || SessionFlags(configuration, flags) != _flags) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::unique_ptr<cricket::PortAllocator> allocator;
+  if (_allocators.empty()) {
+    _misses++;
+  } else {
+    _hits++;
+    allocator = std::move(_allocators.front());
+    _allocators.pop_front();
+  }
+  Refill();
+  return allocator;
+}
+
+PortAllocatorPool::Stats PortAllocatorPool::stats() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return {_size, _allocators.size(), _hits, _misses};
+}
+
+void PortAllocatorPool::Refill() {
+  // Called with _mutex held.
+  if (!_valid) {
+    return;
+  }
+  while (_allocators.size() + _creating < _size) {
+    _creating++;
+    auto alive = _alive;
+    _networkThread->PostTask(RTC_FROM_HERE, [this, alive]() {
+      if (!*alive) {
+        return;
+      }
+      auto allocator = CreateWarmAllocator();
+      std::lock_guard<std::mutex> lock(_mutex);
+      _creating--;
+      _allocators.push_back(std::move(allocator));
+    });
+  }
+}
+
+std::unique_ptr<cricket::PortAllocator> PortAllocatorPool::CreateWarmAllocator() {
+  TRACE_EVENT0("node_webrtc", "PortAllocatorPool::CreateWarmAllocator");
+  auto allocator = std::unique_ptr<cricket::PortAllocator>(new cricket::BasicPortAllocator(
+      _networkManager,
+      _socketFactory));
+  allocator->Initialize();
+  allocator->SetPortRange(_minPort, _maxPort);
+  allocator->set_flags(_flags);
+  allocator->set_step_delay(cricket::kMinimumStepDelay);
+  // This creates the pooled session and starts it gathering.
+  allocator->SetConfiguration(_stunServers, _turnServers, 1, webrtc::NO_PRUNE);
+  return allocator;
+}
+
+}  // namespace node_webrtc
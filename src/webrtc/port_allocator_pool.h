@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <webrtc/api/peer_connection_interface.h>
+#include <webrtc/p2p/base/port_allocator.h>
+
+#include "src/dictionaries/node_webrtc/unsigned_short_range.h"
+
+namespace rtc {
+
+class NetworkManager;
+class PacketSocketFactory;
+class Thread;
+
+}  // namespace rtc
+
+namespace node_webrtc {
+
+/**
+ * PortAllocatorPool keeps a number of BasicPortAllocators warm: each one has
+ * a pooled PortAllocatorSession that has already started gathering host and
+ * server-reflexive candidates against the pool's ICE servers. An
+ * RTCPeerConnection created with the same ICE servers, port range and
+ * allocator flags takes one instead of creating its own, and its first ICE
+ * transport then takes the pooled session, candidates and all. The pool
+ * starts warming a replacement for every allocator it hands out.
+ *
+ * The pool is created and destroyed on the network thread, before the
+ * NetworkManager and PacketSocketFactory it shares. Take and stats are
+ * thread-safe.
+ */
+class PortAllocatorPool {
+ public:
+  struct Stats {
+    size_t size;
+    size_t available;
+    uint64_t hits;
+    uint64_t misses;
+  };
+
+  PortAllocatorPool(
+      rtc::Thread* networkThread,
+      rtc::NetworkManager* networkManager,
+      rtc::PacketSocketFactory* socketFactory,
+      size_t size,
+      const webrtc::PeerConnectionInterface::IceServers& iceServers,
+      const UnsignedShortRange& portRange,
+      uint32_t flags);
+
+  ~PortAllocatorPool();
+
+  /**
+   * Take a warm allocator for an RTCPeerConnection.
+   * @param flags the allocator flags the RTCPeerConnection adds to its own
+   * @return an allocator, or nullptr if none is ready or the pool's allocators
+   * do not gather the way the RTCPeerConnection would
+   */
+  std::unique_ptr<cricket::PortAllocator> Take(
+      const webrtc::PeerConnectionInterface::RTCConfiguration& configuration,
+      const UnsignedShortRange& portRange,
+      uint32_t flags);
+
+  Stats stats();
+
+ private:
+  void Refill();
+  std::unique_ptr<cricket::PortAllocator> CreateWarmAllocator();
+
+  rtc::Thread* _networkThread;
+  rtc::NetworkManager* _networkManager;
+  rtc::PacketSocketFactory* _socketFactory;
+  const size_t _size;
+  const webrtc::PeerConnectionInterface::IceServers _iceServers;
+  const uint16_t _minPort;
+  const uint16_t _maxPort;
+  const int _flags;
+  bool _valid = false;
+  cricket::ServerAddresses _stunServers;
+  std::vector<cricket::RelayServerConfig> _turnServers;
+
+  std::mutex _mutex{};
+  std::deque<std::unique_ptr<cricket::PortAllocator>> _allocators;  // Guarded by _mutex
+  size_t _creating = 0;  // Guarded by _mutex
+  uint64_t _hits = 0;  // Guarded by _mutex
+  uint64_t _misses = 0;  // Guarded by _mutex
+
+  // Refills run on the network thread, which is where this is destroyed too.
+  std::shared_ptr<bool> _alive = std::make_shared<bool>(true);
+};
+
+}  // namespace node_webrtc
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/prebinding_packet_socket_factory.h"
+
+#include <webrtc/rtc_base/async_packet_socket.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/socket_address.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/trace_event.h>
+
+namespace node_webrtc {
+
+PrebindingPacketSocketFactory::PrebindingPacketSocketFactory(
+    rtc::Thread* thread,
+    size_t poolSize,
+    bool batch,
+    uint32_t receiveBufferSize,
+    uint32_t sendBufferSize)
+  : BatchingPacketSocketFactory(thread, batch, receiveBufferSize, sendBufferSize)
+  , _thread(thread)
+  , _poolSize(poolSize) {}
+
+PrebindingPacketSocketFactory::~PrebindingPacketSocketFactory() {
+  *_alive = false;
+}
+
+rtc::AsyncPacketSocket* PrebindingPacketSocketFactory::CreateUdpSocket(
+    const rtc::SocketAddress& address,
+    uint16_t min_port,
+    uint16_t max_port) {
+  // Only pool requests for any port of an address, which is what host
+  // candidates ask for; a specific port is bound as usual.
+  auto anyPort = address.port() == 0;
+  auto roomy = (min_port == 0 && max_port == 0)
+      || static_cast<size_t>(max_port - min_port) + 1 >= 4 * _poolSize;
+  if (!_poolSize || !anyPort || !roomy) {
+    return BatchingPacketSocketFactory::CreateUdpSocket(address, min_port, max_port);
+  }
+
+  Key key(address.ipaddr(), min_port, max_port);
+  auto& pool = _pools[key];
+  std::unique_ptr<rtc::AsyncPacketSocket> socket;
+  if (!pool.empty()) {
+    socket = std::move(pool.front());
+    pool.pop_front();
+  }
+  Refill(key);
+  return socket
+      ? socket.release()
+      : BatchingPacketSocketFactory::CreateUdpSocket(address, min_port, max_port);
+}
+
+void PrebindingPacketSocketFactory::Refill(const Key& key) {
+  if (_refilling[key]) {
+    return;
+  }
+  _refilling[key] = true;
+  // Bind after the allocator's current step, rather than during it.
+  auto alive = _alive;
+  _thread->PostTask(RTC_FROM_HERE, [this, key, alive]() {
+    if (!*alive) {
+      return;
+    }
+    TRACE_EVENT0("node_webrtc", "PrebindingPacketSocketFactory::Refill");
+    _refilling[key] = false;
+    auto& pool = _pools[key];
+    while (pool.size() < _poolSize) {
+      auto socket = BatchingPacketSocketFactory::CreateUdpSocket(
+          rtc::SocketAddress(std::get<0>(key), 0),
+          std::get<1>(key),
+          std::get<2>(key));
+      if (!socket) {
+        break;
+      }
+      pool.emplace_back(socket);
+    }
+  });
+}
+
+}  // namespace node_webrtc
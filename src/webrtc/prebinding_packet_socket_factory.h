@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2022 Astronaut Labs, LLC. All rights reserved.
+ * Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include <webrtc/rtc_base/ip_address.h>
+
+#include "src/webrtc/batching_packet_socket_factory.h"
+
+namespace rtc {
+
+class AsyncPacketSocket;
+class SocketAddress;
+class Thread;
+
+}  // namespace rtc
+
+namespace node_webrtc {
+
+/**
+ * PrebindingPacketSocketFactory keeps a few UDP sockets bound ahead of time
+ * for each local address and port range that allocators have asked for, so
+ * that gathering host candidates takes a bound socket rather than searching
+ * the port range with bind calls. The pool for a local address and port range
+ * fills on the network thread after its first use, and refills after each
+ * socket it hands out.
+ *
+ * Port ranges narrower than four times the pool size are not prebound, so
+ * that idle sockets never starve connections of ports.
+ *
+ * The sockets themselves are BatchingPacketSocketFactory's. Like it, this
+ * must only be used on the network thread.
+ */
+class PrebindingPacketSocketFactory: public BatchingPacketSocketFactory {
+ public:
+  PrebindingPacketSocketFactory(
+      rtc::Thread* thread,
+      size_t poolSize,
+      bool batch,
+      uint32_t receiveBufferSize,
+      uint32_t sendBufferSize);
+
+  ~PrebindingPacketSocketFactory() override;
+
+  rtc::AsyncPacketSocket* CreateUdpSocket(
+      const rtc::SocketAddress& address,
+      uint16_t min_port,
+      uint16_t max_port) override;
+
+ private:
+  using Key = std::tuple<rtc::IPAddress, uint16_t, uint16_t>;
+
+  void Refill(const Key&);
+
+  rtc::Thread* _thread;
+  const size_t _poolSize;
+  std::map<Key, std::deque<std::unique_ptr<rtc::AsyncPacketSocket>>> _pools;
+  std::map<Key, bool> _refilling;
+  // Refills run on the network thread, which is where this is destroyed too.
+  std::shared_ptr<bool> _alive = std::make_shared<bool>(true);
+};
+
+}  // namespace node_webrtc
@@ -31,6 +31,7 @@
 #include <webrtc/rtc_base/thread.h>
 #include <webrtc/rtc_base/thread_annotations.h>
 #include <webrtc/rtc_base/time_utils.h>
+#include <webrtc/rtc_base/trace_event.h>
 
 namespace node_webrtc {
 
@@ -60,8 +61,10 @@ class TestAudioDeviceModuleImpl  // NOLINT
       audio_callback_(nullptr),
       rendering_(false),
       capturing_(false),
+      playout_paused_(false),
       done_rendering_(true, true),
       done_capturing_(true, true),
+      wake_up_(false, false),
       stop_thread_(false) {
     auto good_sample_rate = [](auto sr) {
       return sr == 8000 || sr == 16000 || sr == 32000 || sr == 44100 ||
@@ -87,6 +90,7 @@ class TestAudioDeviceModuleImpl  // NOLINT
         rtc::CritScope cs(&lock_);
         stop_thread_ = true;
       }
+      wake_up_.Set();
       thread_.Finalize();
     }
   }
@@ -117,6 +121,7 @@ class TestAudioDeviceModuleImpl  // NOLINT
     RTC_CHECK(renderer_);
     rendering_ = true;
     done_rendering_.Reset();
+    wake_up_.Set();
     return 0;
   }
 
@@ -132,6 +137,7 @@ class TestAudioDeviceModuleImpl  // NOLINT
     RTC_CHECK(capturer_);
     capturing_ = true;
     done_capturing_.Reset();
+    wake_up_.Set();
     return 0;
   }
 
@@ -152,6 +158,12 @@ class TestAudioDeviceModuleImpl  // NOLINT
     return capturing_;
   }
 
+  void SetPlayoutPaused(bool paused) override {
+    rtc::CritScope cs(&lock_);
+    playout_paused_ = paused;
+    wake_up_.Set();
+  }
+
   // Blocks until the Renderer refuses to receive data.
   // Returns false if |timeout_ms| passes before that happens.
   bool WaitForPlayoutEnd(int timeout_ms = rtc::Event::kForever) override {
@@ -169,11 +181,14 @@ class TestAudioDeviceModuleImpl  // NOLINT
     int64_t time_us = rtc::TimeMicros();
     bool logged_once = false;
     for (;;) {
+      bool idle;
       {
         rtc::CritScope cs(&lock_);
         if (stop_thread_) {
           return;
         }
+        // Capturing is disabled below, so only rendering keeps us busy.
+        idle = !rendering_ || playout_paused_;
         // NOTE(mroberts): I've disabled this, as it was causing the following
         // error (and it's not really used by node-webrtc).
         //
@@ -198,7 +213,8 @@ class TestAudioDeviceModuleImpl  // NOLINT
           }
         }
         */
-        if (rendering_) {
+        if (!idle) {
+          TRACE_EVENT0("node_webrtc", "TestAudioDeviceModule::Render");
           size_t samples_out = 0;
           int64_t elapsed_time_ms = -1;
           int64_t ntp_time_ms = -1;
@@ -218,6 +234,13 @@ class TestAudioDeviceModuleImpl  // NOLINT
           }
         }
       }
+      if (idle) {
+        // Sleep until playout or recording starts, or playout is resumed,
+        // rather than waking every 10 ms with nothing to do.
+        wake_up_.Wait(rtc::Event::kForever);
+        time_us = rtc::TimeMicros();
+        continue;
+      }
       time_us += process_interval_us_;
 
       int64_t time_left_us = time_us - rtc::TimeMicros();
@@ -249,8 +272,10 @@ class TestAudioDeviceModuleImpl  // NOLINT
   webrtc::AudioTransport* audio_callback_ RTC_GUARDED_BY(lock_);
   bool rendering_ RTC_GUARDED_BY(lock_);
   bool capturing_ RTC_GUARDED_BY(lock_);
+  bool playout_paused_ RTC_GUARDED_BY(lock_);
   rtc::Event done_rendering_;
   rtc::Event done_capturing_;
+  rtc::Event wake_up_;
 
   std::vector<int16_t> playout_buffer_ RTC_GUARDED_BY(lock_);
   rtc::BufferT<int16_t> recording_buffer_ RTC_GUARDED_BY(lock_);
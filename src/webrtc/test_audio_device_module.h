@@ -140,6 +140,10 @@ class TestAudioDeviceModule : public webrtc::AudioDeviceModule {
 
   bool Recording() const override = 0;
 
+  // While playout is paused, the device neither pulls nor renders audio, even
+  // if playout has been started, so nothing is decoded or mixed for it.
+  virtual void SetPlayoutPaused(bool paused) = 0;
+
   // Blocks until the Renderer refuses to receive data.
   // Returns false if |timeout_ms| passes before that happens.
   virtual bool WaitForPlayoutEnd(int timeout_ms = rtc::Event::kForever) = 0;